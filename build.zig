@@ -42,7 +42,10 @@ pub fn build(b: *std.Build) void {
 
     // Utility sources (always included)
     const utility_sources = [_][]const u8{
+        "src/current_cpu.c",
         "src/filesystem.c",
+        "src/hugepages.c",
+        "src/resctrl.c",
         "src/stack_line_reader.c",
         "src/string_view.c",
     };
@@ -70,9 +73,9 @@ pub fn build(b: *std.Build) void {
         });
     }
 
-    // Unix-based hardware detection (for non-x86 Unix platforms)
+    // Unix-based hardware detection
     // Note: Android is represented as Linux in Zig's target system
-    if (os_tag != .windows and !cpu_arch.isX86()) {
+    if (os_tag != .windows) {
         const hwcaps_sources = [_][]const u8{
             "src/hwcaps.c",
             "src/hwcaps_linux_or_android.c",
@@ -172,10 +175,18 @@ pub fn build(b: *std.Build) void {
         .riscv32, .riscv64 => {
             // RISC-V architecture
             if (os_tag == .linux) {
-                cpu_mod.addCSourceFile(.{
-                    .file = b.path("src/impl_riscv_linux.c"),
-                    .flags = &c_flags,
-                });
+                const riscv_sources = [_][]const u8{
+                    "src/impl_riscv_cpuid.c",
+                    "src/impl_riscv_hwprobe.c",
+                    "src/impl_riscv_linux.c",
+                };
+
+                for (riscv_sources) |source| {
+                    cpu_mod.addCSourceFile(.{
+                        .file = b.path(source),
+                        .flags = &c_flags,
+                    });
+                }
             }
             cpu_features.installHeader(b.path("include/cpuinfo_riscv.h"), "cpuinfo_riscv.h");
         },
@@ -206,6 +217,9 @@ pub fn build(b: *std.Build) void {
 
     cpu_features.installHeader(b.path("include/cpu_features_cache_info.h"), "cpu_features_cache_info.h");
     cpu_features.installHeader(b.path("include/cpu_features_macros.h"), "cpu_features_macros.h");
+    cpu_features.installHeader(b.path("include/cpu_features_current_cpu.h"), "cpu_features_current_cpu.h");
+    cpu_features.installHeader(b.path("include/cpu_features_resctrl.h"), "cpu_features_resctrl.h");
+    cpu_features.installHeader(b.path("include/cpu_features_security.h"), "cpu_features_security.h");
 
     // Link against dl library on Unix-like systems
     if (os_tag != .windows and os_tag != .wasi) {
@@ -49,6 +49,81 @@ typedef struct {
   CacheLevelInfo levels[CPU_FEATURES_MAX_CACHE_LEVEL];
 } CacheInfo;
 
+typedef enum {
+  CPU_FEATURE_TLB_NULL = 0,
+  CPU_FEATURE_TLB_DATA = 1,
+  CPU_FEATURE_TLB_INSTRUCTION = 2,
+  CPU_FEATURE_TLB_UNIFIED = 3,
+  CPU_FEATURE_TLB_LOAD = 4,   // Data TLB serving loads only.
+  CPU_FEATURE_TLB_STORE = 5,  // Data TLB serving stores only.
+} TlbType;
+
+typedef struct {
+  int level;
+  TlbType tlb_type;
+  int page_4k : 1;  // Translates 4 KiB pages.
+  int page_2m : 1;  // Translates 2 MiB pages.
+  int page_4m : 1;  // Translates 4 MiB pages.
+  int page_1g : 1;  // Translates 1 GiB pages.
+  int entries;      // Number of entries
+  int ways;         // Associativity, 0 undefined, 0xFF fully associative
+} TlbLevelInfo;
+
+// Increase this value if more TLB levels are needed.
+#ifndef CPU_FEATURES_MAX_TLB_LEVEL
+#define CPU_FEATURES_MAX_TLB_LEVEL 16
+#endif
+typedef struct {
+  int size;
+  TlbLevelInfo levels[CPU_FEATURES_MAX_TLB_LEVEL];
+} TlbInfo;
+
+typedef enum {
+  CPU_FEATURE_THP_UNKNOWN = 0,
+  CPU_FEATURE_THP_NEVER = 1,
+  CPU_FEATURE_THP_MADVISE = 2,
+  CPU_FEATURE_THP_ALWAYS = 3,
+} ThpMode;
+
+typedef enum {
+  CPU_FEATURE_THP_DEFRAG_UNKNOWN = 0,
+  CPU_FEATURE_THP_DEFRAG_NEVER = 1,
+  CPU_FEATURE_THP_DEFRAG_MADVISE = 2,
+  CPU_FEATURE_THP_DEFRAG_DEFER = 3,
+  CPU_FEATURE_THP_DEFRAG_DEFER_MADVISE = 4,
+  CPU_FEATURE_THP_DEFRAG_ALWAYS = 5,
+} ThpDefrag;
+
+// Increase this value if more NUMA nodes are needed.
+#ifndef CPU_FEATURES_MAX_NUMA_NODES
+#define CPU_FEATURES_MAX_NUMA_NODES 8
+#endif
+typedef struct {
+  int size_kb;  // Huge page size in KiB
+  int total;    // Pages in the hugetlb pool, -1 if unknown
+  int free;     // Pages of the hugetlb pool not in use, -1 if unknown
+  // Per node, indexed like HugePageInfo.node_ids, -1 if unknown
+  int node_total[CPU_FEATURES_MAX_NUMA_NODES];
+  int node_free[CPU_FEATURES_MAX_NUMA_NODES];
+} HugePageSize;
+
+// Increase this value if more huge page sizes are needed.
+#ifndef CPU_FEATURES_MAX_HUGE_PAGE_SIZES
+#define CPU_FEATURES_MAX_HUGE_PAGE_SIZES 8
+#endif
+typedef struct {
+  int page_size;         // Base page size in bytes, 0 if unknown
+  ThpMode thp_enabled;   // Transparent huge pages policy
+  ThpDefrag thp_defrag;  // Transparent huge pages compaction policy
+  int thp_size_kb;       // Transparent huge page size in KiB, 0 if unknown
+  int nodes;             // Number of online NUMA nodes in node_ids
+  int nodes_truncated;   // Set if more nodes are online than node_ids holds
+  // Online NUMA node ids in increasing order, they may not be contiguous.
+  int node_ids[CPU_FEATURES_MAX_NUMA_NODES];
+  int size;              // Number of huge page sizes supported by the cpu
+  HugePageSize sizes[CPU_FEATURES_MAX_HUGE_PAGE_SIZES];
+} HugePageInfo;
+
 CPU_FEATURES_END_CPP_NAMESPACE
 
 #endif  // CPU_FEATURES_INCLUDE_CPUINFO_COMMON_H_
@@ -0,0 +1,54 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Finds the cpu the calling thread runs on, as needed by per-cpu data
+// structures. The cheapest mechanism available is selected once.
+#ifndef CPU_FEATURES_INCLUDE_CPU_FEATURES_CURRENT_CPU_H_
+#define CPU_FEATURES_INCLUDE_CPU_FEATURES_CURRENT_CPU_H_
+
+#include "cpu_features_macros.h"
+
+CPU_FEATURES_START_CPP_NAMESPACE
+
+// Mechanisms to get the current cpu, usually from the cheapest to the most
+// expensive. The time_current_cpu utility measures them on a given host.
+typedef enum {
+  CPU_FEATURE_CURRENT_CPU_NONE = 0,    // Not available on this OS.
+  CPU_FEATURE_CURRENT_CPU_RSEQ = 1,    // Load from the glibc rseq area.
+  CPU_FEATURE_CURRENT_CPU_RDPID = 2,   // TSC_AUX through RDPID.
+  CPU_FEATURE_CURRENT_CPU_RDTSCP = 3,  // TSC_AUX through RDTSCP.
+  CPU_FEATURE_CURRENT_CPU_OS = 4,      // sched_getcpu (vDSO on Linux) or
+                                       // GetCurrentProcessorNumber.
+} CurrentCpuMethod;
+
+// Returns the mechanism used by `CpuFeatures_GetCurrentCpu`.
+CurrentCpuMethod CpuFeatures_GetCurrentCpuMethod(void);
+
+// Returns the index of the cpu the calling thread runs on, -1 if unknown. The
+// thread may be migrated as soon as the function returns so the result is only
+// a hint.
+int CpuFeatures_GetCurrentCpu(void);
+
+// Returns whether `method` works on this host and OS.
+int CpuFeatures_IsCurrentCpuMethodAvailable(CurrentCpuMethod method);
+
+// Same as `CpuFeatures_GetCurrentCpu` with a given mechanism, e.g. to compare
+// their costs. Only pass an available method: RDPID and RDTSCP fault on cpus
+// lacking them.
+int CpuFeatures_GetCurrentCpuWithMethod(CurrentCpuMethod method);
+
+CPU_FEATURES_END_CPP_NAMESPACE
+
+#endif  // CPU_FEATURES_INCLUDE_CPU_FEATURES_CURRENT_CPU_H_
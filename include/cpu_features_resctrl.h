@@ -0,0 +1,74 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Reads the cache occupancy and memory bandwidth counters that the Linux
+// resctrl filesystem exposes for monitoring groups.
+// https://docs.kernel.org/arch/x86/resctrl.html
+#ifndef CPU_FEATURES_INCLUDE_CPU_FEATURES_RESCTRL_H_
+#define CPU_FEATURES_INCLUDE_CPU_FEATURES_RESCTRL_H_
+
+#include <stdint.h>  // int64_t
+
+#include "cpu_features_macros.h"
+
+CPU_FEATURES_START_CPP_NAMESPACE
+
+// Increase this value if more L3 monitoring domains are needed.
+#ifndef CPU_FEATURES_MAX_RESCTRL_DOMAINS
+#define CPU_FEATURES_MAX_RESCTRL_DOMAINS 16
+#endif
+
+// Counters of one L3 monitoring domain, -1 when not available.
+typedef struct {
+  int id;                   // L3 cache id, from the mon_L3_<id> directory.
+  int64_t llc_occupancy;    // In bytes.
+  int64_t mbm_total_bytes;  // Bytes transferred to and from memory.
+  int64_t mbm_local_bytes;  // Bytes transferred to and from local memory.
+} ResctrlDomainCounters;
+
+typedef struct {
+  int size;
+  // Set when there are more domains than CPU_FEATURES_MAX_RESCTRL_DOMAINS,
+  // the ones with the lowest ids are kept.
+  int truncated;
+  ResctrlDomainCounters domains[CPU_FEATURES_MAX_RESCTRL_DOMAINS];
+} ResctrlMonData;
+
+// Creates the monitoring group /sys/fs/resctrl/mon_groups/<name>. Returns 0 on
+// success and -1 otherwise, e.g. when resctrl is not mounted or the group
+// already exists.
+int CreateResctrlMonGroup(const char* name);
+
+// Removes a monitoring group, its tasks move back to the parent group. Returns
+// 0 on success and -1 otherwise.
+int RemoveResctrlMonGroup(const char* name);
+
+// Moves the task `tid` to a monitoring group. Returns 0 on success and -1
+// otherwise.
+int AddTaskToResctrlMonGroup(const char* name, int tid);
+
+// Reads the counters of a monitoring group, or of the default group when
+// `name` is NULL. Returns an empty result when resctrl is not available.
+ResctrlMonData ReadResctrlMonData(const char* name);
+
+// Returns the difference between two reads of the same group. Bandwidth
+// counters become the number of bytes transferred in between, occupancy is
+// taken from `current` as it is not cumulative.
+ResctrlMonData GetResctrlMonDataDelta(const ResctrlMonData* previous,
+                                      const ResctrlMonData* current);
+
+CPU_FEATURES_END_CPP_NAMESPACE
+
+#endif  // CPU_FEATURES_INCLUDE_CPU_FEATURES_RESCTRL_H_
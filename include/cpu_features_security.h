@@ -0,0 +1,47 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Security extensions described the same way on every architecture.
+#ifndef CPU_FEATURES_INCLUDE_CPU_FEATURES_SECURITY_H_
+#define CPU_FEATURES_INCLUDE_CPU_FEATURES_SECURITY_H_
+
+#include "cpu_features_macros.h"
+
+CPU_FEATURES_START_CPP_NAMESPACE
+
+// Architecture neutral view of the cryptographic extensions, so that crypto
+// libraries can dispatch the same way on every architecture.
+typedef struct {
+  int aes : 1;              // AES rounds
+  int clmul : 1;            // Carry-less (polynomial) multiplication
+  int sha1 : 1;             // SHA-1 message schedule and rounds
+  int sha256 : 1;           // SHA-224/SHA-256 message schedule and rounds
+  int sha512 : 1;           // SHA-384/SHA-512 message schedule and rounds
+  int sha3 : 1;             // SHA-3 helper instructions
+  int sm3 : 1;              // ShangMi 3 hash
+  int sm4 : 1;              // ShangMi 4 block cipher
+  int aes_wrapped_key : 1;  // AES with hardware wrapped keys
+} CryptoFeatures;
+
+// Architecture neutral view of memory protection keys, which change the access
+// rights of tagged pages from user space without a syscall.
+typedef struct {
+  int supported;  // The cpu and the OS support x86 PKU or aarch64 POE.
+  int num_keys;   // Keys the process can allocate, -1 if unknown.
+} ProtectionKeys;
+
+CPU_FEATURES_END_CPP_NAMESPACE
+
+#endif  // CPU_FEATURES_INCLUDE_CPU_FEATURES_SECURITY_H_
@@ -111,6 +111,7 @@
 
 #include "cpu_features_cache_info.h"
 #include "cpu_features_macros.h"
+#include "cpu_features_security.h"
 
 CPU_FEATURES_START_CPP_NAMESPACE
 
@@ -218,6 +219,8 @@ typedef struct {
   int smesf8dp2 : 1;  // SVE2 FP8 to half-precision 2-way dot product FDOT
                       // (2-way) instructions.
   int poe : 1;        // Stage 1 Permission Overlay.
+  int mtefar : 1;        // MTE reports all the faulting address bits.
+  int mtestoreonly : 1;  // MTE tag checks restricted to stores.
 
   // Make sure to update Aarch64FeaturesEnum below if you add a field here.
 } Aarch64Features;
@@ -233,6 +236,39 @@ typedef struct {
 
 Aarch64Info GetAarch64Info(void);
 
+// Same features as `GetAarch64Info().features` but, where the OS provides
+// them, they are read from the hardware capabilities only. On Linux this avoids
+// parsing /proc/cpuinfo which is slow and often not accessible in sandboxes.
+Aarch64Features GetAarch64Features(void);
+
+// Returns the cryptographic extensions in `features` in an architecture
+// neutral form.
+CryptoFeatures GetAarch64CryptoFeatures(const Aarch64Features* features);
+
+// Returns whether POE can be used and how many keys the process may allocate.
+// On Linux the keys are counted by briefly allocating every free key, a
+// concurrent pkey_alloc from another thread may fail meanwhile.
+ProtectionKeys GetAarch64ProtectionKeys(void);
+
+// Returns the huge page sizes allowed by the translation granule in use along
+// with the OS configuration, see `HugePageInfo`.
+HugePageInfo GetAarch64HugePageInfo(void);
+
+// The top byte of user pointers is always ignored by loads and stores (TBI),
+// this describes whether the OS accepts tagged pointers as well.
+// https://docs.kernel.org/arch/arm64/tagged-address-abi.html
+typedef struct {
+  // Tagged pointers may be passed to syscalls, -1 if unknown.
+  int tagged_addr_enabled;
+  // Memory Tagging Extension tag check faults, -1 if unknown.
+  int mte_tcf_sync;
+  int mte_tcf_async;
+  int mte_tag_mask;  // Tags allowed to be generated by IRG, -1 if unknown.
+} Aarch64TaggedAddressControl;
+
+// Returns the tagged address ABI of the calling thread.
+Aarch64TaggedAddressControl GetAarch64TaggedAddressControl(void);
+
 ////////////////////////////////////////////////////////////////////////////////
 // Introspection functions
 
@@ -333,6 +369,8 @@ typedef enum {
   AARCH64_SME_SF8DP4,
   AARCH64_SME_SF8DP2,
   AARCH64_POE,
+  AARCH64_MTE_FAR,
+  AARCH64_MTE_STORE_ONLY,
   AARCH64_LAST_,
 } Aarch64FeaturesEnum;
 
@@ -71,6 +71,11 @@ typedef struct {
 
 ArmInfo GetArmInfo(void);
 
+// Same features as `GetArmInfo().features` but read from the hardware
+// capabilities only. /proc/cpuinfo is parsed only when the platform may be
+// affected by one of the kernel bugs that GetArmInfo works around.
+ArmFeatures GetArmFeatures(void);
+
 // Compute CpuId from ArmInfo.
 uint32_t GetArmCpuId(const ArmInfo* const info);
 
@@ -39,12 +39,96 @@ typedef struct {
   int V : 1;         // Standard Extension for Vector Instructions
   int Zicsr : 1;     // Control and Status Register (CSR)
   int Zifencei : 1;  // Instruction-Fetch Fence
+
+  // Multi-letter extensions
+  int Zicbom : 1;       // Cache-Block Management Instructions
+  int Zicboz : 1;       // Cache-Block Zero Instructions
+  int Zicond : 1;       // Integer Conditional Operations
+  int Zihintntl : 1;    // Non-Temporal Locality Hints
+  int Zihintpause : 1;  // Pause Hint
+  int Zawrs : 1;        // Wait-on-Reservation-Set Instructions
+  int Zacas : 1;        // Atomic Compare-and-Swap Instructions
+  int Ztso : 1;         // Total Store Ordering
+  int Zfa : 1;          // Additional Floating-Point Instructions
+  int Zfh : 1;          // Half-Precision Floating-Point
+  int Zfhmin : 1;       // Minimal Half-Precision Floating-Point
+
+  // Bit-manipulation
+  int Zba : 1;  // Address Generation Instructions
+  int Zbb : 1;  // Basic Bit-Manipulation
+  int Zbc : 1;  // Carry-Less Multiplication
+  int Zbs : 1;  // Single-Bit Instructions
+
+  // Scalar cryptography
+  int Zbkb : 1;   // Bit-Manipulation for Cryptography
+  int Zbkc : 1;   // Carry-Less Multiplication for Cryptography
+  int Zbkx : 1;   // Crossbar Permutations
+  int Zknd : 1;   // NIST Suite: AES Decryption
+  int Zkne : 1;   // NIST Suite: AES Encryption
+  int Zknh : 1;   // NIST Suite: Hash Function Instructions
+  int Zksed : 1;  // ShangMi Suite: SM4 Block Cipher Instructions
+  int Zksh : 1;   // ShangMi Suite: SM3 Hash Function Instructions
+  int Zkt : 1;    // Data Independent Execution Latency
+
+  // Vector cryptography
+  int Zvbb : 1;    // Vector Basic Bit-Manipulation
+  int Zvbc : 1;    // Vector Carry-Less Multiplication
+  int Zvkb : 1;    // Vector Cryptography Bit-Manipulation
+  int Zvkg : 1;    // Vector GCM/GMAC
+  int Zvkned : 1;  // NIST Suite: Vector AES Block Cipher
+  int Zvknha : 1;  // NIST Suite: Vector SHA-2 Secure Hash (SHA-256)
+  int Zvknhb : 1;  // NIST Suite: Vector SHA-2 Secure Hash (SHA-256/512)
+  int Zvksed : 1;  // ShangMi Suite: SM4 Block Cipher
+  int Zvksh : 1;   // ShangMi Suite: SM3 Secure Hash
+  int Zvkt : 1;    // Vector Data-Independent Execution Latency
+
+  // Vector floating-point
+  int Zvfh : 1;     // Vector Half-Precision Floating-Point
+  int Zvfhmin : 1;  // Vector Minimal Half-Precision Floating-Point
+
+  // Vector subsets for embedded processors
+  int Zve32x : 1;  // Vector with 32-bit integer elements
+  int Zve32f : 1;  // Vector with 32-bit integer and float elements
+  int Zve64x : 1;  // Vector with 64-bit integer elements
+  int Zve64f : 1;  // Vector with 64-bit integer and 32-bit float elements
+  int Zve64d : 1;  // Vector with 64-bit integer and float elements
+
+  // Minimum vector length, hwprobe has no bit for these so they are read from
+  // the isa string even when hwprobe is available.
+  int Zvl32b : 1;    // VLEN >= 32
+  int Zvl64b : 1;    // VLEN >= 64
+  int Zvl128b : 1;   // VLEN >= 128
+  int Zvl256b : 1;   // VLEN >= 256
+  int Zvl512b : 1;   // VLEN >= 512
+  int Zvl1024b : 1;  // VLEN >= 1024
+
+  // Vendor extensions
+  int XTheadBa : 1;       // T-Head Address Calculation
+  int XTheadBb : 1;       // T-Head Basic Bit-Manipulation
+  int XTheadBs : 1;       // T-Head Single-Bit Instructions
+  int XTheadCondMov : 1;  // T-Head Conditional Move
+  int XTheadVector : 1;   // T-Head Vector (RVV 0.7.1)
+
+  // Make sure to update RiscvFeaturesEnum below if you add a field here.
 } RiscvFeatures;
 
+// Performance of misaligned scalar accesses as reported by the kernel.
+typedef enum {
+  RISCV_MISALIGNED_UNKNOWN,
+  RISCV_MISALIGNED_EMULATED,     // Trapped and emulated by the kernel.
+  RISCV_MISALIGNED_SLOW,         // Slower than equivalent byte accesses.
+  RISCV_MISALIGNED_FAST,         // Faster than equivalent byte accesses.
+  RISCV_MISALIGNED_UNSUPPORTED,  // Not supported, they raise a fault.
+} RiscvMisalignedAccessSpeed;
+
 typedef struct {
   RiscvFeatures features;
   char uarch[64];   // 0 terminated string
   char vendor[64];  // 0 terminated string
+  // The two fields below are only available through the riscv_hwprobe syscall
+  // (Linux 6.4+).
+  RiscvMisalignedAccessSpeed misaligned_access_speed;
+  int zicboz_block_size;  // Size in bytes of the cbo.zero block, 0 if unknown.
 } RiscvInfo;
 
 typedef enum {
@@ -59,10 +143,71 @@ typedef enum {
   RISCV_V,
   RISCV_Zicsr,
   RISCV_Zifencei,
+  RISCV_Zicbom,
+  RISCV_Zicboz,
+  RISCV_Zicond,
+  RISCV_Zihintntl,
+  RISCV_Zihintpause,
+  RISCV_Zawrs,
+  RISCV_Zacas,
+  RISCV_Ztso,
+  RISCV_Zfa,
+  RISCV_Zfh,
+  RISCV_Zfhmin,
+  RISCV_Zba,
+  RISCV_Zbb,
+  RISCV_Zbc,
+  RISCV_Zbs,
+  RISCV_Zbkb,
+  RISCV_Zbkc,
+  RISCV_Zbkx,
+  RISCV_Zknd,
+  RISCV_Zkne,
+  RISCV_Zknh,
+  RISCV_Zksed,
+  RISCV_Zksh,
+  RISCV_Zkt,
+  RISCV_Zvbb,
+  RISCV_Zvbc,
+  RISCV_Zvkb,
+  RISCV_Zvkg,
+  RISCV_Zvkned,
+  RISCV_Zvknha,
+  RISCV_Zvknhb,
+  RISCV_Zvksed,
+  RISCV_Zvksh,
+  RISCV_Zvkt,
+  RISCV_Zvfh,
+  RISCV_Zvfhmin,
+  RISCV_Zve32x,
+  RISCV_Zve32f,
+  RISCV_Zve64x,
+  RISCV_Zve64f,
+  RISCV_Zve64d,
+  RISCV_Zvl32b,
+  RISCV_Zvl64b,
+  RISCV_Zvl128b,
+  RISCV_Zvl256b,
+  RISCV_Zvl512b,
+  RISCV_Zvl1024b,
+  RISCV_XTheadBa,
+  RISCV_XTheadBb,
+  RISCV_XTheadBs,
+  RISCV_XTheadCondMov,
+  RISCV_XTheadVector,
   RISCV_LAST_,
 } RiscvFeaturesEnum;
 
+// Vector register geometry, all values are in bits. vlen is only read when
+// the kernel reports V in AT_HWCAP and enables it for the calling thread.
+typedef struct {
+  int vlen;  // Width of a vector register, 0 if vectors are not usable.
+  int elen;  // Widest supported element, 0 if vectors are not usable.
+  int zvl;   // Minimum VLEN guaranteed by the Zvl*b, Zve* or V extensions.
+} RiscvVectorInfo;
+
 RiscvInfo GetRiscvInfo(void);
+RiscvVectorInfo GetRiscvVectorInfo(void);
 int GetRiscvFeaturesEnumValue(const RiscvFeatures* features,
                               RiscvFeaturesEnum value);
 const char* GetRiscvFeaturesEnumName(RiscvFeaturesEnum);
@@ -16,8 +16,11 @@
 #ifndef CPU_FEATURES_INCLUDE_CPUINFO_X86_H_
 #define CPU_FEATURES_INCLUDE_CPUINFO_X86_H_
 
+#include <stdint.h>  // uint64_t
+
 #include "cpu_features_cache_info.h"
 #include "cpu_features_macros.h"
+#include "cpu_features_security.h"
 
 CPU_FEATURES_START_CPP_NAMESPACE
 
@@ -33,6 +36,8 @@ CPU_FEATURES_START_CPP_NAMESPACE
 typedef struct {
   int fpu : 1;
   int tsc : 1;
+  int rdtscp : 1;
+  int rdpid : 1;
   int cx8 : 1;
   int clfsh : 1;
   int mmx : 1;
@@ -47,9 +52,18 @@ typedef struct {
   int hle : 1;
   int bmi2 : 1;
   int rtm : 1;
+  int rtm_always_abort : 1;  // Microcode makes every RTM transaction abort
+  int tsx_force_abort : 1;   // TSX_FORCE_ABORT MSR is available
+  int rtm_usable : 1;        // RTM not disabled by microcode, see also
+                             // IsX86RtmUsable
   int rdseed : 1;
   int clflushopt : 1;
   int clwb : 1;
+  int cldemote : 1;
+  int prefetchw : 1;
+  int prefetchi : 1;
+  int clzero : 1;
+  int wbnoinvd : 1;
 
   int sse : 1;
   int sse2 : 1;
@@ -61,6 +75,10 @@ typedef struct {
 
   int avx : 1;
   int avx_vnni : 1;
+  int avx_vnni_int8 : 1;
+  int avx_vnni_int16 : 1;
+  int avx_ifma : 1;
+  int avx_ne_convert : 1;
   int avx2 : 1;
 
   int avx512f : 1;
@@ -83,34 +101,55 @@ typedef struct {
   int avx512_bf16 : 1;
   int avx512_vp2intersect : 1;
   int avx512_fp16 : 1;
+  int avx10 : 1;      // Converged vector ISA, see avx10_version
+  int avx10_256 : 1;  // AVX10 with 256-bit vectors
+  int avx10_512 : 1;  // AVX10 with 512-bit vectors
   int amx_bf16 : 1;
   int amx_tile : 1;
   int amx_int8 : 1;
   int amx_fp16 : 1;
+  int amx_complex : 1;
+  int amx_fp8 : 1;
+  int apx_f : 1;  // Advanced Performance Extensions, 32 GPRs
 
   int pclmulqdq : 1;
   int smx : 1;
   int sgx : 1;
   int cx16 : 1;  // aka. CMPXCHG16B
   int sha : 1;
+  int sha512 : 1;
+  int sm3 : 1;
+  int sm4 : 1;
+  int kl : 1;       // Key Locker
+  int aeskle : 1;   // AES Key Locker instructions
+  int wide_kl : 1;  // AES wide Key Locker instructions
   int popcnt : 1;
   int movbe : 1;
   int rdrnd : 1;
 
   int dca : 1;
   int ss : 1;
+  int hypervisor : 1;
   int adx : 1;
   int lzcnt : 1;  // Note: this flag is called ABM for AMD, LZCNT for Intel.
   int gfni : 1;
   int movdiri : 1;
   int movdir64b : 1;
+  int waitpkg : 1;             // UMONITOR, UMWAIT and TPAUSE
+  int serialize : 1;           // Serializes instruction execution
+  int uintr : 1;               // User interrupts
+  int monitorx : 1;            // AMD MONITORX and MWAITX
+  int hreset : 1;              // History reset
   int fs_rep_mov : 1;          // Fast short REP MOV
   int fz_rep_movsb : 1;        // Fast zero-length REP MOVSB
   int fs_rep_stosb : 1;        // Fast short REP STOSB
   int fs_rep_cmpsb_scasb : 1;  // Fast short REP CMPSB/SCASB
 
-  int lam : 1;  // Intel Linear Address Mask
-  int uai : 1;  // AMD Upper Address Ignore
+  int lam : 1;       // Intel Linear Address Mask
+  int uai : 1;       // AMD Upper Address Ignore
+  int pku : 1;       // Protection keys for user-mode pages
+  int ospke : 1;     // OS has enabled protection keys
+  int fsgsbase : 1;  // RDFSBASE/WRFSBASE, faults until the OS enables it
   // Make sure to update X86FeaturesEnum below if you add a field here.
 } X86Features;
 
@@ -121,15 +160,347 @@ typedef struct {
   int stepping;
   char vendor[13];        // 0 terminated string
   char brand_string[49];  // 0 terminated string
+  int avx10_version;      // AVX10 version, 0 if AVX10 is not supported.
+  int avx10_max_vl;       // Widest AVX10 vector length in bits.
 } X86Info;
 
 // Calls cpuid and returns an initialized X86info.
 X86Info GetX86Info(void);
 
+// Returns whether CPUID traps to the kernel or to a user space handler, as
+// under rr or after arch_prctl(ARCH_SET_CPUID, 0). Each CPUID then costs
+// thousands of cycles and may return values the kernel did not enable. This
+// costs a syscall and is never called by the other getters: when it returns
+// true, call EnableX86CpuidCache or use GetX86InfoFromOs.
+int IsX86CpuidFaulting(void);
+
+// Returns whether RTM transactions can commit: rtm_usable is set and the OS
+// has not disabled TSX, e.g. with tsx=off or the TAA mitigation. On Linux
+// this reads /proc/cpuinfo and sysfs, so cache the result.
+int IsX86RtmUsable(void);
+
+// Makes all the getters read each CPUID leaf once per process. This is done
+// automatically under a hypervisor, not when CPUID faults. It has no effect
+// with compilers lacking GNU atomics.
+void EnableX86CpuidCache(void);
+
+// Same as GetX86Info but without executing CPUID: the vendor, model and
+// features are the ones the OS reports, e.g. /proc/cpuinfo and AT_HWCAP2 on
+// Linux. Other OSes fall back to GetX86Info. Linux has no cpuinfo flag for
+// prefetchi, avx_vnni_int8, avx_vnni_int16, avx_ne_convert, avx10*,
+// amx_complex, amx_fp8, apx_f, kl, aeskle, wide_kl, uintr, hreset and uai:
+// these are never reported, nor are avx10_version and avx10_max_vl.
+X86Info GetX86InfoFromOs(void);
+
 // Returns cache hierarchy information.
 // Can call cpuid multiple times.
 CacheInfo GetX86CacheInfo(void);
 
+// Returns the TLBs, one entry per level, type and set of page sizes. Uses CPUID
+// leaf 0x18 on Intel and leaves 0x80000005, 0x80000006 and 0x80000019 on AMD.
+TlbInfo GetX86TlbInfo(void);
+
+// Returns the huge page sizes supported by the CPU along with the OS
+// configuration, see `HugePageInfo`.
+HugePageInfo GetX86HugePageInfo(void);
+
+// Increase this value if more XSAVE state components are needed.
+#ifndef CPU_FEATURES_MAX_XSAVE_COMPONENTS
+#define CPU_FEATURES_MAX_XSAVE_COMPONENTS 32
+#endif
+
+// Describes a state component of the XSAVE area, see CPUID leaf 0xD.
+typedef struct {
+  int size;        // Size in bytes, 0 if the component is not supported.
+  int offset;      // Offset in the standard format, 0 for supervisor state.
+  int supervisor;  // Whether the component is enabled through IA32_XSS.
+  int aligned;     // Whether it is 64-byte aligned in the compacted format.
+  int xfd;         // Whether it supports eXtended Feature Disable.
+} X86XSaveComponent;
+
+typedef struct {
+  int xsaveopt : 1;
+  int xsavec : 1;
+  int xgetbv_ecx1 : 1;
+  int xsaves : 1;
+  int xfd : 1;  // eXtended Feature Disable (IA32_XFD)
+
+  uint64_t user_components;        // Components that can be set in XCR0.
+  uint64_t supervisor_components;  // Components that can be set in IA32_XSS.
+  uint64_t enabled_components;     // Components enabled by the OS in XCR0.
+
+  int enabled_size;  // Standard format size for the components in XCR0.
+  int max_size;      // Standard format size for all user components.
+  int enabled_compacted_size;  // Compacted size for XCR0 | IA32_XSS.
+  X86XSaveComponent components[CPU_FEATURES_MAX_XSAVE_COMPONENTS];
+} X86XSaveInfo;
+
+// Returns the layout of the XSAVE area.
+// Calls cpuid once per supported state component.
+X86XSaveInfo GetX86XSaveInfo(void);
+
+// Returns the size in bytes of a compacted XSAVE area (as written by XSAVEC or
+// XSAVES) holding the state components in `mask`, or 0 if one of them is not
+// supported.
+int GetX86XSaveCompactedSize(const X86XSaveInfo* info, uint64_t mask);
+
+// Returns the cryptographic extensions in `features` in an architecture
+// neutral form. SHA-NI covers both SHA-1 and SHA-256, x86 has no SHA-3.
+CryptoFeatures GetX86CryptoFeatures(const X86Features* features);
+
+// Returns whether PKU can be used and how many keys the process may allocate.
+// On Linux the keys are counted by briefly allocating every free key, a
+// concurrent pkey_alloc from another thread may fail meanwhile.
+ProtectionKeys GetX86ProtectionKeys(void);
+
+// Increase this value if more AMX palettes are needed.
+#ifndef CPU_FEATURES_MAX_AMX_PALETTES
+#define CPU_FEATURES_MAX_AMX_PALETTES 4
+#endif
+
+// Describes an AMX tile palette, see CPUID leaf 0x1D.
+typedef struct {
+  int total_tile_bytes;
+  int bytes_per_tile;
+  int bytes_per_row;
+  int max_names;  // Number of tile registers.
+  int max_rows;
+} X86AmxPalette;
+
+typedef struct {
+  // Highest supported palette, palette 0 is the initialization state.
+  int max_palette;
+  X86AmxPalette palettes[CPU_FEATURES_MAX_AMX_PALETTES];  // Indexed by id.
+  // TMUL limits, see CPUID leaf 0x1E.
+  int tmul_max_k;  // Rows or columns.
+  int tmul_max_n;  // Column bytes.
+} X86AmxInfo;
+
+// Returns the AMX tile geometry, zeroed if AMX is not supported.
+X86AmxInfo GetX86AmxInfo(void);
+
+typedef enum {
+  X86_AMX_PERMISSION_UNSUPPORTED,  // The cpu or the OS does not support AMX.
+  X86_AMX_PERMISSION_DENIED,       // AMX is supported but not usable yet.
+  X86_AMX_PERMISSION_GRANTED,      // AMX instructions can be used.
+} X86AmxPermission;
+
+// Returns whether the calling process may use AMX tile data.
+X86AmxPermission GetX86AmxPermission(void);
+
+// Linux requires processes to request AMX tile data before use, the first
+// tile instruction raises SIGILL otherwise. This requests the permission for
+// the whole process and returns the resulting state. Other OSes grant it
+// implicitly.
+X86AmxPermission RequestX86AmxPermission(void);
+
+// Limits put by the OS on UMWAIT and TPAUSE through IA32_UMWAIT_CONTROL.
+typedef struct {
+  int max_time;     // In TSC quanta, 0 means no limit and -1 unknown.
+  int c02_enabled;  // Whether the C0.2 state may be entered, -1 if unknown.
+} X86UmwaitControl;
+
+// Returns the UMWAIT limits, only available on Linux when waitpkg is set.
+X86UmwaitControl GetX86UmwaitControl(void);
+
+// Address widths and the pointer bits available for tagging.
+typedef struct {
+  // From CPUID leaf 0x80000008, 0 if unknown.
+  int physical_address_bits;
+  int virtual_address_bits;  // 48 with 4-level paging, 57 with 5-level paging.
+  int la57;                  // The cpu supports 5-level paging.
+  // Whether the OS uses 5-level paging, -1 if unknown. Linux only hands out
+  // addresses above 47 bits to mmap calls asking for them.
+  int la57_enabled;
+  // Upper bits the OS can ignore on user pointers through Intel LAM, -1 if
+  // unknown. AMD UAI is not enabled for user space by any OS so far.
+  int max_tag_bits;
+  int tag_bits;  // Tag bits currently enabled for the process, -1 if unknown.
+} X86AddressSpace;
+
+// Returns the address widths and the tagging state of the calling process.
+X86AddressSpace GetX86AddressSpace(void);
+
+// Enables Intel LAM for the calling process so that the `tag_bits` upper bits
+// of user pointers are ignored. Linux only accepts this before the process
+// creates threads. Returns 0 on success, -1 if LAM is not supported or the OS
+// refused.
+int EnableX86TaggedAddresses(int tag_bits);
+
+// Hardware profiling facilities.
+typedef struct {
+  // Performance monitoring counters, see CPUID leaves 0xA and 0x80000022.
+  int pmu_version;          // Intel architectural PMU version, 0 if none.
+  int gp_counters;          // General purpose counters per logical processor.
+  int gp_counter_width;     // In bits.
+  int fixed_counters;       // Intel fixed function counters.
+  int fixed_counter_width;  // In bits.
+  int pdcm : 1;             // IA32_PERF_CAPABILITIES, PEBS and LBR formats.
+  int ds : 1;               // Debug store, holds the BTS and PEBS buffers.
+  int arch_lbr : 1;         // Intel architectural LBR, see CPUID leaf 0x1C.
+  int perfmon_v2 : 1;       // AMD PerfMonV2 global control and status.
+  int amd_lbr_v2 : 1;       // AMD LBR stack.
+  int lbr_depth;            // Maximum number of branch records, 0 if unknown.
+
+  // Intel Processor Trace, see CPUID leaf 0x14.
+  int intel_pt : 1;
+  int pt_cr3_filtering : 1;        // Tracing limited to an address space.
+  int pt_cycle_accurate : 1;       // CYC packets.
+  int pt_ip_filtering : 1;         // Tracing limited to address ranges.
+  int pt_mtc : 1;                  // Mini time counter packets.
+  int pt_ptwrite : 1;              // PTWRITE packets.
+  int pt_power_event_trace : 1;    // Power event packets.
+  int pt_topa : 1;                 // Table of physical addresses output.
+  int pt_single_range_output : 1;  // Contiguous output buffer.
+  int pt_address_ranges;           // Number of configurable address ranges.
+
+  // AMD Instruction Based Sampling, see CPUID leaf 0x8000001B.
+  int ibs : 1;
+  int ibs_fetch_sampling : 1;     // Instruction fetch sampling.
+  int ibs_op_sampling : 1;        // Micro-op execution sampling.
+  int ibs_branch_target : 1;      // Branch target address is reported.
+  int ibs_l3_miss_filtering : 1;  // Samples can be limited to L3 misses.
+
+  // Linux perf_event PMUs from /sys/bus/event_source/devices, they tell
+  // whether the kernel drives the features above. -1 if unknown.
+  int perf_cpu;        // Core counters ("cpu" or "cpu_core" on hybrid parts).
+  int perf_intel_pt;   // "intel_pt"
+  int perf_ibs_fetch;  // "ibs_fetch"
+  int perf_ibs_op;     // "ibs_op"
+} X86ProfilingInfo;
+
+// Returns the performance monitoring and tracing capabilities.
+X86ProfilingInfo GetX86ProfilingInfo(void);
+
+// Resource Director Technology (Intel) and Platform QoS (AMD).
+typedef struct {
+  // Monitoring, see CPUID leaf 0xF.
+  int cmt : 1;               // LLC occupancy monitoring.
+  int mbm_total : 1;         // Total memory bandwidth monitoring.
+  int mbm_local : 1;         // Local memory bandwidth monitoring.
+  int mon_rmids;             // Number of L3 resource monitoring ids.
+  int mon_upscaling_factor;  // Bytes per unit of the monitoring counters.
+  int mbm_counter_width;     // In bits.
+
+  // Allocation, see CPUID leaf 0x10 and 0x80000020.
+  int l3_cat : 1;      // L3 cache allocation.
+  int l3_cdp : 1;      // L3 code and data prioritization.
+  int l2_cat : 1;      // L2 cache allocation.
+  int l2_cdp : 1;      // L2 code and data prioritization.
+  int mba : 1;         // Memory bandwidth allocation.
+  int mba_linear : 1;  // The Intel delay values are linear.
+  int l3_cat_classes;  // Number of classes of service.
+  int l3_cbm_length;   // Capacity bitmask length in bits.
+  int l2_cat_classes;
+  int l2_cbm_length;
+  int mba_classes;
+  // Intel: maximum delay in percent, AMD: maximum bandwidth limit.
+  int mba_max_value;
+  // Intel with linear delays: the bandwidth percentage is set in steps of
+  // mba_granularity and cannot go below it, 0 otherwise.
+  int mba_granularity;
+
+  // Resources exposed by the mounted Linux resctrl filesystem under
+  // /sys/fs/resctrl/info, -1 if unknown or not enabled by the kernel.
+  int resctrl_l3_classes;
+  int resctrl_l2_classes;
+  int resctrl_mba_classes;
+  int resctrl_mon_rmids;
+  // Bandwidth percentage step and lower bound accepted in schemata MB lines.
+  int resctrl_mba_granularity;
+  int resctrl_mba_min_bandwidth;
+} X86RdtInfo;
+
+// Returns the cache and memory bandwidth monitoring and allocation
+// capabilities.
+X86RdtInfo GetX86RdtInfo(void);
+
+typedef enum {
+  X86_HYPERVISOR_NONE,     // Running on bare metal.
+  X86_HYPERVISOR_UNKNOWN,  // The hypervisor bit is set.
+  X86_HYPERVISOR_KVM,      // Also Firecracker and other KVM based VMMs.
+  X86_HYPERVISOR_HYPERV,
+  X86_HYPERVISOR_XEN,
+  X86_HYPERVISOR_VMWARE,
+  X86_HYPERVISOR_BHYVE,
+  X86_HYPERVISOR_QEMU_TCG,
+} X86HypervisorVendor;
+
+// Hypervisor and paravirtual features, from CPUID leaves 0x40000000 and up.
+// Every CPUID executed in a guest exits to the hypervisor, cache the result.
+typedef struct {
+  X86HypervisorVendor vendor;  // The hypervisor at leaf 0x40000000.
+  char signature[13];          // Its raw signature, e.g. "KVMKVMKVM".
+  uint32_t max_leaf;           // Its highest leaf.
+  int tsc_khz;                 // TSC frequency from leaf 0x40000010, or 0.
+
+  // KVM paravirtual features, also found when KVM emulates Hyper-V.
+  int kvm_clocksource : 1;     // kvmclock, more reliable than the raw TSC.
+  int kvm_async_pf : 1;        // Asynchronous page faults.
+  int kvm_steal_time : 1;      // Time stolen by other guests is accounted.
+  int kvm_pv_eoi : 1;          // Paravirtual end of interrupt.
+  int kvm_pv_unhalt : 1;       // Paravirtual spinlocks can kick halted vcpus.
+  int kvm_pv_tlb_flush : 1;    // Remote TLB flushes skip preempted vcpus.
+  int kvm_pv_send_ipi : 1;     // IPIs to many vcpus with one hypercall.
+  int kvm_poll_control : 1;    // Host side polling can be disabled.
+  int kvm_pv_sched_yield : 1;  // Yield to a preempted vcpu.
+  int kvm_hint_realtime : 1;   // vcpus are never preempted.
+
+  // Hyper-V enlightenments.
+  int hyperv_reference_counter : 1;   // Partition reference counter.
+  int hyperv_synic : 1;               // Synthetic interrupt controller.
+  int hyperv_synthetic_timers : 1;    // Synthetic timers.
+  int hyperv_apic_msrs : 1;           // APIC access through MSRs.
+  int hyperv_hypercall_msrs : 1;      // Hypercall page.
+  int hyperv_vp_index : 1;            // Virtual processor index MSR.
+  int hyperv_reference_tsc : 1;       // Reference TSC page.
+  int hyperv_frequency_msrs : 1;      // TSC and APIC frequencies MSRs.
+  int hyperv_remote_tlb_flush : 1;    // Flush remote TLBs by hypercall.
+  int hyperv_relaxed_timing : 1;      // Watchdogs should be disabled.
+  int hyperv_ex_processor_masks : 1;  // Sparse vcpu sets in hypercalls.
+  // Spin attempts before notifying the hypervisor, -1 means never.
+  int hyperv_spinlock_retries;
+} X86HypervisorInfo;
+
+// Returns the hypervisor the process runs under, zeroed on bare metal.
+X86HypervisorInfo GetX86HypervisorInfo(void);
+
+typedef enum {
+  X86_CC_GUEST_NONE,
+  X86_CC_GUEST_TDX,      // Intel Trust Domain Extensions.
+  X86_CC_GUEST_SEV,      // AMD SEV, encrypted memory.
+  X86_CC_GUEST_SEV_ES,   // AMD SEV-ES, encrypted registers as well.
+  X86_CC_GUEST_SEV_SNP,  // AMD SEV-SNP, integrity protected memory as well.
+} X86ConfidentialGuest;
+
+// Memory encryption capabilities and confidential guest state. In TDX and
+// SEV-ES guests CPUID raises #VE or #VC and DMA goes through bounce buffers.
+typedef struct {
+  // The kind of confidential guest the process runs in. TDX is reported by
+  // CPUID, SEV guests are only reported by Linux.
+  X86ConfidentialGuest guest;
+  // Each CPUID traps, the leaves read by cpu_features are cached.
+  int cpuid_expensive : 1;
+
+  // Intel Total Memory Encryption, the number of MKTME keys is only exposed
+  // through IA32_TME_CAPABILITY which user space cannot read.
+  int tme : 1;
+
+  // AMD memory encryption, see CPUID leaf 0x8000001F.
+  int sme : 1;                     // Secure Memory Encryption.
+  int sev : 1;                     // Secure Encrypted Virtualization.
+  int sev_es : 1;                  // SEV Encrypted State.
+  int sev_snp : 1;                 // SEV Secure Nested Paging.
+  int c_bit_position;              // Page table bit marking encrypted pages.
+  int physical_address_reduction;  // Physical address bits lost to the C-bit.
+  int encrypted_guests;            // Encrypted guests supported at once.
+  int min_sev_no_es_asid;          // Lowest ASID for SEV guests without ES.
+} X86ConfidentialInfo;
+
+// Returns the memory encryption capabilities and whether the process runs in
+// a confidential guest.
+X86ConfidentialInfo GetX86ConfidentialInfo(void);
+
 typedef enum {
   X86_UNKNOWN,
   ZHAOXIN_ZHANGJIANG,   // ZhangJiang
@@ -208,6 +579,8 @@ void FillX86BrandString(char brand_string[49]);
 typedef enum {
   X86_FPU,
   X86_TSC,
+  X86_RDTSCP,
+  X86_RDPID,
   X86_CX8,
   X86_CLFSH,
   X86_MMX,
@@ -222,9 +595,17 @@ typedef enum {
   X86_HLE,
   X86_BMI2,
   X86_RTM,
+  X86_RTM_ALWAYS_ABORT,
+  X86_TSX_FORCE_ABORT,
+  X86_RTM_USABLE,
   X86_RDSEED,
   X86_CLFLUSHOPT,
   X86_CLWB,
+  X86_CLDEMOTE,
+  X86_PREFETCHW,
+  X86_PREFETCHI,
+  X86_CLZERO,
+  X86_WBNOINVD,
   X86_SSE,
   X86_SSE2,
   X86_SSE3,
@@ -234,6 +615,10 @@ typedef enum {
   X86_SSE4A,
   X86_AVX,
   X86_AVX_VNNI,
+  X86_AVX_VNNI_INT8,
+  X86_AVX_VNNI_INT16,
+  X86_AVX_IFMA,
+  X86_AVX_NE_CONVERT,
   X86_AVX2,
   X86_AVX512F,
   X86_AVX512CD,
@@ -255,31 +640,52 @@ typedef enum {
   X86_AVX512_BF16,
   X86_AVX512_VP2INTERSECT,
   X86_AVX512_FP16,
+  X86_AVX10,
+  X86_AVX10_256,
+  X86_AVX10_512,
   X86_AMX_BF16,
   X86_AMX_TILE,
   X86_AMX_INT8,
   X86_AMX_FP16,
+  X86_AMX_COMPLEX,
+  X86_AMX_FP8,
+  X86_APX_F,
   X86_PCLMULQDQ,
   X86_SMX,
   X86_SGX,
   X86_CX16,
   X86_SHA,
+  X86_SHA512,
+  X86_SM3,
+  X86_SM4,
+  X86_KL,
+  X86_AESKLE,
+  X86_WIDE_KL,
   X86_POPCNT,
   X86_MOVBE,
   X86_RDRND,
   X86_DCA,
   X86_SS,
+  X86_HYPERVISOR,
   X86_ADX,
   X86_LZCNT,
   X86_GFNI,
   X86_MOVDIRI,
   X86_MOVDIR64B,
+  X86_WAITPKG,
+  X86_SERIALIZE,
+  X86_UINTR,
+  X86_MONITORX,
+  X86_HRESET,
   X86_FS_REP_MOV,
   X86_FZ_REP_MOVSB,
   X86_FS_REP_STOSB,
   X86_FS_REP_CMPSB_SCASB,
   X86_LAM,
   X86_UAI,
+  X86_PKU,
+  X86_OSPKE,
+  X86_FSGSBASE,
   X86_LAST_,
 } X86FeaturesEnum;
 
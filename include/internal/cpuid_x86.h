@@ -32,6 +32,11 @@ Leaf GetCpuidLeaf(uint32_t leaf_id, int ecx);
 // Returns the eax value of the XCR0 register.
 uint32_t GetXCR0Eax(void);
 
+#if defined(CPU_FEATURES_MOCK_CPUID_X86)
+// Forgets the cached leaves, to be called before each test.
+void ResetX86CpuidCacheForTesting(void);
+#endif  // CPU_FEATURES_MOCK_CPUID_X86
+
 CPU_FEATURES_END_CPP_NAMESPACE
 
 #endif  // CPU_FEATURES_INCLUDE_INTERNAL_CPUID_X86_H_
@@ -34,6 +34,33 @@ int CpuFeatures_ReadFile(int file_descriptor, void* buffer, size_t buffer_size);
 // Same as linux "close(file_descriptor)".
 void CpuFeatures_CloseFile(int file_descriptor);
 
+// Same as linux "open(filename, O_WRONLY)", retries automatically on EINTR.
+int CpuFeatures_OpenFileForWriting(const char* filename);
+
+// Same as linux "write(file_descriptor, buffer, buffer_size)", retries
+// automatically on EINTR.
+int CpuFeatures_WriteFile(int file_descriptor, const void* buffer,
+                          size_t buffer_size);
+
+// Same as linux "mkdir(path, 0755)".
+int CpuFeatures_CreateDirectory(const char* path);
+
+// Same as linux "rmdir(path)".
+int CpuFeatures_RemoveDirectory(const char* path);
+
+// An open directory, see CpuFeatures_OpenDirectory.
+typedef struct CpuFeatures_Directory CpuFeatures_Directory;
+
+// Same as linux "opendir(path)", returns NULL on error.
+CpuFeatures_Directory* CpuFeatures_OpenDirectory(const char* path);
+
+// Same as linux "readdir(directory)" but only returns the name of the entry,
+// NULL once all of them have been read. The name is valid until the next call.
+const char* CpuFeatures_ReadDirectory(CpuFeatures_Directory* directory);
+
+// Same as linux "closedir(directory)".
+void CpuFeatures_CloseDirectory(CpuFeatures_Directory* directory);
+
 CPU_FEATURES_END_CPP_NAMESPACE
 
 #endif  // CPU_FEATURES_INCLUDE_INTERNAL_FILESYSTEM_H_
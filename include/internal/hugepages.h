@@ -0,0 +1,39 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Reads the huge page configuration of the OS.
+#ifndef CPU_FEATURES_INCLUDE_INTERNAL_HUGEPAGES_H_
+#define CPU_FEATURES_INCLUDE_INTERNAL_HUGEPAGES_H_
+
+#include "cpu_features_cache_info.h"
+#include "cpu_features_macros.h"
+
+CPU_FEATURES_START_CPP_NAMESPACE
+
+// Appends a huge page size supported by the cpu, its pool is unknown.
+void CpuFeatures_AddHugePageSize(HugePageInfo* info, int size_kb);
+
+// Fills the transparent huge page policy, the online NUMA nodes and the
+// hugetlb pools of the sizes already in `info`. On Linux it reads
+// /sys/kernel/mm and /sys/devices/system/node, it does nothing on other OSes.
+void CpuFeatures_FillHugePageInfoFromOs(HugePageInfo* info);
+
+// Returns the default huge page size of the kernel in KiB, 0 if unknown. On
+// Linux it reads /proc/meminfo.
+int CpuFeatures_GetDefaultHugePageSizeFromOs(void);
+
+CPU_FEATURES_END_CPP_NAMESPACE
+
+#endif  // CPU_FEATURES_INCLUDE_INTERNAL_HUGEPAGES_H_
@@ -125,6 +125,8 @@ CPU_FEATURES_START_CPP_NAMESPACE
 #define AARCH64_HWCAP2_SME_SF8DP4 (UINT64_C(1) << 61)
 #define AARCH64_HWCAP2_SME_SF8DP2 (UINT64_C(1) << 62)
 #define AARCH64_HWCAP2_POE (UINT64_C(1) << 63)
+#define AARCH64_HWCAP3_MTE_FAR (UINT64_C(1) << 0)
+#define AARCH64_HWCAP3_MTE_STORE_ONLY (UINT64_C(1) << 1)
 
 // http://elixir.free-electrons.com/linux/latest/source/arch/arm/include/uapi/asm/hwcap.h
 #define ARM_HWCAP_SWP (UINT64_C(1) << 0)
@@ -274,17 +276,33 @@ CPU_FEATURES_START_CPP_NAMESPACE
 #define HWCAP_LOONGARCH_LBT_MIPS (UINT64_C(1) << 12)
 #define HWCAP_LOONGARCH_PTW (UINT64_C(1) << 13)
 
+// AT_HWCAP holds CPUID.1:EDX as masked by the kernel.
+#define X86_HWCAP_FPU (UINT64_C(1) << 0)
+#define X86_HWCAP_TSC (UINT64_C(1) << 4)
+#define X86_HWCAP_CX8 (UINT64_C(1) << 8)
+#define X86_HWCAP_CLFSH (UINT64_C(1) << 19)
+#define X86_HWCAP_MMX (UINT64_C(1) << 23)
+#define X86_HWCAP_SSE (UINT64_C(1) << 25)
+#define X86_HWCAP_SSE2 (UINT64_C(1) << 26)
+#define X86_HWCAP_SS (UINT64_C(1) << 27)
+// https://elixir.bootlin.com/linux/latest/source/arch/x86/include/uapi/asm/hwcap2.h
+#define X86_HWCAP2_RING3MWAIT (UINT64_C(1) << 0)
+#define X86_HWCAP2_FSGSBASE (UINT64_C(1) << 1)
+
 typedef struct {
   uint64_t hwcaps;
   uint64_t hwcaps2;
+  uint64_t hwcaps3;
+  uint64_t hwcaps4;
 } HardwareCapabilities;
 
-// Retrieves values from auxiliary vector for types AT_HWCAP and AT_HWCAP2.
-// First tries to call getauxval(), if not available falls back to reading
-// "/proc/self/auxv".
+// Retrieves values from auxiliary vector for types AT_HWCAP, AT_HWCAP2,
+// AT_HWCAP3 and AT_HWCAP4. First tries to call getauxval(), if not available
+// falls back to reading "/proc/self/auxv" once.
 HardwareCapabilities CpuFeatures_GetHardwareCapabilities(void);
 
-// Checks whether value for AT_HWCAP (or AT_HWCAP2) match hwcaps_mask.
+// Checks whether value for AT_HWCAP (or AT_HWCAP2, AT_HWCAP3, AT_HWCAP4) match
+// hwcaps_mask.
 bool CpuFeatures_IsHwCapsSet(const HardwareCapabilities hwcaps_mask,
                              const HardwareCapabilities hwcaps);
 
@@ -292,6 +310,11 @@ bool CpuFeatures_IsHwCapsSet(const HardwareCapabilities hwcaps_mask,
 const char* CpuFeatures_GetPlatformPointer(void);
 // Get pointer for the AT_BASE_PLATFORM type.
 const char* CpuFeatures_GetBasePlatformPointer(void);
+// Get the minimal signal stack size (AT_MINSIGSTKSZ) needed by the kernel to
+// deliver a signal with the current register state, 0 if unknown.
+unsigned long CpuFeatures_GetMinSigStackSize(void);
+// Get the base page size (AT_PAGESZ) in bytes, 0 if unknown.
+unsigned long CpuFeatures_GetPageSize(void);
 
 CPU_FEATURES_END_CPP_NAMESPACE
 
@@ -0,0 +1,115 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Interface to the Linux `riscv_hwprobe` syscall, available since Linux 6.4.
+// https://docs.kernel.org/arch/riscv/hwprobe.html
+#ifndef CPU_FEATURES_INCLUDE_INTERNAL_HWPROBE_RISCV_H_
+#define CPU_FEATURES_INCLUDE_INTERNAL_HWPROBE_RISCV_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cpu_features_macros.h"
+
+CPU_FEATURES_START_CPP_NAMESPACE
+
+// To avoid depending on the linux kernel we reproduce the constants here.
+// https://elixir.bootlin.com/linux/latest/source/arch/riscv/include/uapi/asm/hwprobe.h
+#define RISCV_HWPROBE_KEY_MVENDORID 0
+#define RISCV_HWPROBE_KEY_MARCHID 1
+#define RISCV_HWPROBE_KEY_MIMPID 2
+#define RISCV_HWPROBE_KEY_BASE_BEHAVIOR 3
+#define RISCV_HWPROBE_BASE_BEHAVIOR_IMA (UINT64_C(1) << 0)
+#define RISCV_HWPROBE_KEY_IMA_EXT_0 4
+#define RISCV_HWPROBE_IMA_FD (UINT64_C(1) << 0)
+#define RISCV_HWPROBE_IMA_C (UINT64_C(1) << 1)
+#define RISCV_HWPROBE_IMA_V (UINT64_C(1) << 2)
+#define RISCV_HWPROBE_EXT_ZBA (UINT64_C(1) << 3)
+#define RISCV_HWPROBE_EXT_ZBB (UINT64_C(1) << 4)
+#define RISCV_HWPROBE_EXT_ZBS (UINT64_C(1) << 5)
+#define RISCV_HWPROBE_EXT_ZICBOZ (UINT64_C(1) << 6)
+#define RISCV_HWPROBE_EXT_ZBC (UINT64_C(1) << 7)
+#define RISCV_HWPROBE_EXT_ZBKB (UINT64_C(1) << 8)
+#define RISCV_HWPROBE_EXT_ZBKC (UINT64_C(1) << 9)
+#define RISCV_HWPROBE_EXT_ZBKX (UINT64_C(1) << 10)
+#define RISCV_HWPROBE_EXT_ZKND (UINT64_C(1) << 11)
+#define RISCV_HWPROBE_EXT_ZKNE (UINT64_C(1) << 12)
+#define RISCV_HWPROBE_EXT_ZKNH (UINT64_C(1) << 13)
+#define RISCV_HWPROBE_EXT_ZKSED (UINT64_C(1) << 14)
+#define RISCV_HWPROBE_EXT_ZKSH (UINT64_C(1) << 15)
+#define RISCV_HWPROBE_EXT_ZKT (UINT64_C(1) << 16)
+#define RISCV_HWPROBE_EXT_ZVBB (UINT64_C(1) << 17)
+#define RISCV_HWPROBE_EXT_ZVBC (UINT64_C(1) << 18)
+#define RISCV_HWPROBE_EXT_ZVKB (UINT64_C(1) << 19)
+#define RISCV_HWPROBE_EXT_ZVKG (UINT64_C(1) << 20)
+#define RISCV_HWPROBE_EXT_ZVKNED (UINT64_C(1) << 21)
+#define RISCV_HWPROBE_EXT_ZVKNHA (UINT64_C(1) << 22)
+#define RISCV_HWPROBE_EXT_ZVKNHB (UINT64_C(1) << 23)
+#define RISCV_HWPROBE_EXT_ZVKSED (UINT64_C(1) << 24)
+#define RISCV_HWPROBE_EXT_ZVKSH (UINT64_C(1) << 25)
+#define RISCV_HWPROBE_EXT_ZVKT (UINT64_C(1) << 26)
+#define RISCV_HWPROBE_EXT_ZFH (UINT64_C(1) << 27)
+#define RISCV_HWPROBE_EXT_ZFHMIN (UINT64_C(1) << 28)
+#define RISCV_HWPROBE_EXT_ZIHINTNTL (UINT64_C(1) << 29)
+#define RISCV_HWPROBE_EXT_ZVFH (UINT64_C(1) << 30)
+#define RISCV_HWPROBE_EXT_ZVFHMIN (UINT64_C(1) << 31)
+#define RISCV_HWPROBE_EXT_ZFA (UINT64_C(1) << 32)
+#define RISCV_HWPROBE_EXT_ZTSO (UINT64_C(1) << 33)
+#define RISCV_HWPROBE_EXT_ZACAS (UINT64_C(1) << 34)
+#define RISCV_HWPROBE_EXT_ZICOND (UINT64_C(1) << 35)
+#define RISCV_HWPROBE_EXT_ZIHINTPAUSE (UINT64_C(1) << 36)
+#define RISCV_HWPROBE_EXT_ZVE32X (UINT64_C(1) << 37)
+#define RISCV_HWPROBE_EXT_ZVE32F (UINT64_C(1) << 38)
+#define RISCV_HWPROBE_EXT_ZVE64X (UINT64_C(1) << 39)
+#define RISCV_HWPROBE_EXT_ZVE64F (UINT64_C(1) << 40)
+#define RISCV_HWPROBE_EXT_ZVE64D (UINT64_C(1) << 41)
+#define RISCV_HWPROBE_EXT_ZIMOP (UINT64_C(1) << 42)
+#define RISCV_HWPROBE_EXT_ZCA (UINT64_C(1) << 43)
+#define RISCV_HWPROBE_EXT_ZCB (UINT64_C(1) << 44)
+#define RISCV_HWPROBE_EXT_ZCD (UINT64_C(1) << 45)
+#define RISCV_HWPROBE_EXT_ZCF (UINT64_C(1) << 46)
+#define RISCV_HWPROBE_EXT_ZCMOP (UINT64_C(1) << 47)
+#define RISCV_HWPROBE_EXT_ZAWRS (UINT64_C(1) << 48)
+#define RISCV_HWPROBE_EXT_ZICBOM (UINT64_C(1) << 55)
+#define RISCV_HWPROBE_KEY_CPUPERF_0 5
+#define RISCV_HWPROBE_MISALIGNED_MASK 7
+#define RISCV_HWPROBE_KEY_ZICBOZ_BLOCK_SIZE 6
+#define RISCV_HWPROBE_KEY_MISALIGNED_SCALAR_PERF 9
+#define RISCV_HWPROBE_KEY_VENDOR_EXT_THEAD_0 11
+#define RISCV_HWPROBE_VENDOR_EXT_XTHEADVECTOR (UINT64_C(1) << 0)
+#define RISCV_HWPROBE_KEY_ZICBOM_BLOCK_SIZE 12
+
+// Mirrors `struct riscv_hwprobe`.
+typedef struct {
+  int64_t key;
+  uint64_t value;
+} RiscvHwprobePair;
+
+// Fills the value of each pair for all online CPUs. Keys unknown to the kernel
+// are set to -1. Returns 0 on success, a negative value if the syscall is not
+// available.
+int GetRiscvHwprobe(RiscvHwprobePair* pairs, size_t pair_count);
+
+// From include/uapi/linux/prctl.h, available since Linux 6.5.
+#define PR_RISCV_V_GET_CONTROL 70
+#define PR_RISCV_V_VSTATE_CTRL_OFF 1
+#define PR_RISCV_V_VSTATE_CTRL_ON 2
+#define PR_RISCV_V_VSTATE_CTRL_CUR_MASK 0x3
+
+// Returns the vector state control of the calling thread or -1 on error.
+long GetRiscvVectorControl(void);
+
+CPU_FEATURES_END_CPP_NAMESPACE
+
+#endif  // CPU_FEATURES_INCLUDE_INTERNAL_HWPROBE_RISCV_H_
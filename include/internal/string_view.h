@@ -18,6 +18,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "cpu_features_macros.h"
@@ -87,9 +88,12 @@ char CpuFeatures_StringView_Back(const StringView view);
 StringView CpuFeatures_StringView_TrimWhitespace(StringView view);
 
 // Convert StringView to positive integer. e.g. "42", "0x2a".
-// Returns -1 on error.
+// Returns -1 on error or overflow.
 int CpuFeatures_StringView_ParsePositiveNumber(const StringView view);
 
+// Same as CpuFeatures_StringView_ParsePositiveNumber for 64-bit values.
+int64_t CpuFeatures_StringView_ParsePositiveNumber64(const StringView view);
+
 // Copies src StringView to dst buffer.
 void CpuFeatures_StringView_CopyString(const StringView src, char* dst,
                                        size_t dst_size);
@@ -0,0 +1,160 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// For sched_getcpu().
+#define _GNU_SOURCE
+
+#include "cpu_features_current_cpu.h"
+
+#include <stdint.h>
+
+#if defined(CPU_FEATURES_ARCH_X86)
+#include "cpuinfo_x86.h"
+#endif  // CPU_FEATURES_ARCH_X86
+
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+#include <sched.h>
+// glibc registers a restartable sequence area for every thread since 2.35.
+#if defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 35))
+#include <sys/rseq.h>
+#define CPU_FEATURES_HAVE_RSEQ
+#endif
+#elif defined(CPU_FEATURES_OS_WINDOWS)
+#include <windows.h>
+#endif
+
+#if defined(CPU_FEATURES_HAVE_RSEQ)
+static const char* GetThreadPointer(void) {
+#if defined(CPU_FEATURES_ARCH_X86_64) && defined(__GNUC__)
+  const char* tp;
+  __asm__("mov %%fs:0, %0" : "=r"(tp));
+  return tp;
+#elif defined(CPU_FEATURES_ARCH_X86_32) && defined(__GNUC__)
+  const char* tp;
+  __asm__("mov %%gs:0, %0" : "=r"(tp));
+  return tp;
+#else
+  return (const char*)__builtin_thread_pointer();
+#endif
+}
+
+static int GetCpuFromRseq(void) {
+  const volatile struct rseq* const area =
+      (const volatile struct rseq*)(GetThreadPointer() + __rseq_offset);
+  return (int)area->cpu_id;
+}
+#endif  // CPU_FEATURES_HAVE_RSEQ
+
+// Linux stores (node << 12) | cpu in IA32_TSC_AUX.
+#if defined(CPU_FEATURES_ARCH_X86) && defined(__GNUC__) && \
+    (defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID))
+#define CPU_FEATURES_HAVE_TSC_AUX
+#define TSC_AUX_CPU_MASK 0xFFF
+
+static int GetCpuFromRdpid(void) {
+  unsigned long aux;
+  __asm__ volatile("rdpid %0" : "=r"(aux));
+  return (int)(aux & TSC_AUX_CPU_MASK);
+}
+
+static int GetCpuFromRdtscp(void) {
+  uint32_t low, high, aux;
+  __asm__ volatile("rdtscp" : "=a"(low), "=d"(high), "=c"(aux));
+  (void)low;
+  (void)high;
+  return (int)(aux & TSC_AUX_CPU_MASK);
+}
+#endif  // CPU_FEATURES_HAVE_TSC_AUX
+
+int CpuFeatures_IsCurrentCpuMethodAvailable(CurrentCpuMethod method) {
+  switch (method) {
+#if defined(CPU_FEATURES_HAVE_RSEQ)
+    case CPU_FEATURE_CURRENT_CPU_RSEQ:
+      // __rseq_size is 0 when glibc could not register the area.
+      return __rseq_size > 0 && GetCpuFromRseq() >= 0;
+#endif
+#if defined(CPU_FEATURES_HAVE_TSC_AUX)
+    case CPU_FEATURE_CURRENT_CPU_RDPID:
+      return GetX86Info().features.rdpid;
+    case CPU_FEATURE_CURRENT_CPU_RDTSCP:
+      return GetX86Info().features.rdtscp;
+#endif
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID) || \
+    defined(CPU_FEATURES_OS_WINDOWS)
+    case CPU_FEATURE_CURRENT_CPU_OS:
+      return 1;
+#endif
+    default:
+      return 0;
+  }
+}
+
+static CurrentCpuMethod SelectCurrentCpuMethod(void) {
+  // The methods are ordered from the cheapest to the most expensive.
+  for (int method = CPU_FEATURE_CURRENT_CPU_RSEQ;
+       method <= CPU_FEATURE_CURRENT_CPU_OS; ++method) {
+    if (CpuFeatures_IsCurrentCpuMethodAvailable((CurrentCpuMethod)method))
+      return (CurrentCpuMethod)method;
+  }
+  return CPU_FEATURE_CURRENT_CPU_NONE;
+}
+
+#if defined(CPU_FEATURES_COMPILER_CLANG) || defined(CPU_FEATURES_COMPILER_GCC)
+// Racing threads select the same method, the first store wins.
+static int g_current_cpu_method = -1;
+
+CurrentCpuMethod CpuFeatures_GetCurrentCpuMethod(void) {
+  int method = __atomic_load_n(&g_current_cpu_method, __ATOMIC_RELAXED);
+  if (method < 0) {
+    method = (int)SelectCurrentCpuMethod();
+    __atomic_store_n(&g_current_cpu_method, method, __ATOMIC_RELAXED);
+  }
+  return (CurrentCpuMethod)method;
+}
+#else
+// Without GNU atomics the method is selected on every call.
+CurrentCpuMethod CpuFeatures_GetCurrentCpuMethod(void) {
+  return SelectCurrentCpuMethod();
+}
+#endif
+
+int CpuFeatures_GetCurrentCpu(void) {
+  return CpuFeatures_GetCurrentCpuWithMethod(CpuFeatures_GetCurrentCpuMethod());
+}
+
+int CpuFeatures_GetCurrentCpuWithMethod(CurrentCpuMethod method) {
+  switch (method) {
+#if defined(CPU_FEATURES_HAVE_RSEQ)
+    case CPU_FEATURE_CURRENT_CPU_RSEQ:
+      return GetCpuFromRseq();
+#endif
+#if defined(CPU_FEATURES_HAVE_TSC_AUX)
+    case CPU_FEATURE_CURRENT_CPU_RDPID:
+      return GetCpuFromRdpid();
+    case CPU_FEATURE_CURRENT_CPU_RDTSCP:
+      return GetCpuFromRdtscp();
+#endif
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+    case CPU_FEATURE_CURRENT_CPU_OS:
+      return sched_getcpu();
+#elif defined(CPU_FEATURES_OS_WINDOWS)
+    case CPU_FEATURE_CURRENT_CPU_OS:
+      return (int)GetCurrentProcessorNumber();
+#endif
+    default:
+      return -1;
+  }
+}
@@ -48,7 +48,7 @@
 #define FEAT_ENUM_LAST FEAT_ENUM_LAST_(INTROSPECTION_ENUM_PREFIX)
 
 // Generate individual getters and setters.
-#define LINE(ENUM, NAME, A, B, C)                                \
+#define LINE(ENUM, NAME, ...)                                    \
   static void set_##ENUM(FEAT_TYPE_NAME* features, bool value) { \
     features->NAME = value;                                      \
   }                                                              \
@@ -59,12 +59,12 @@ INTROSPECTION_TABLE
 #undef LINE
 
 // Generate getters table
-#define LINE(ENUM, NAME, A, B, C) [ENUM] = get_##ENUM,
+#define LINE(ENUM, NAME, ...) [ENUM] = get_##ENUM,
 static int (*const kGetters[])(const FEAT_TYPE_NAME*) = {INTROSPECTION_TABLE};
 #undef LINE
 
 // Generate setters table
-#define LINE(ENUM, NAME, A, B, C) [ENUM] = set_##ENUM,
+#define LINE(ENUM, NAME, ...) [ENUM] = set_##ENUM,
 static void (*const kSetters[])(FEAT_TYPE_NAME*, bool) = {INTROSPECTION_TABLE};
 #undef LINE
 
@@ -75,7 +75,7 @@ int GET_FEAT_ENUM_VALUE(const FEAT_TYPE_NAME* features, FEAT_ENUM_NAME value) {
 }
 
 // Generate feature name table.
-#define LINE(ENUM, NAME, A, B, C) [ENUM] = STRINGIZE(NAME),
+#define LINE(ENUM, NAME, ...) [ENUM] = STRINGIZE(NAME),
 static const char* kFeatureNames[] = {INTROSPECTION_TABLE};
 #undef LINE
 
@@ -15,12 +15,18 @@
 #include "define_introspection.inl"
 #include "internal/hwcaps.h"
 
-#define LINE(ENUM, NAME, CPUINFO_FLAG, HWCAP, HWCAP2) [ENUM] = {HWCAP, HWCAP2},
+// Table lines are LINE(ENUM, NAME, CPUINFO_FLAG, HWCAP, HWCAP2) with optional
+// HWCAP3 and HWCAP4 arguments, the missing ones default to 0.
+#define HWCAPS_(HWCAP, HWCAP2, HWCAP3, HWCAP4, ...) \
+  {.hwcaps = HWCAP, .hwcaps2 = HWCAP2, .hwcaps3 = HWCAP3, .hwcaps4 = HWCAP4}
+#define LINE(ENUM, NAME, CPUINFO_FLAG, ...) \
+  [ENUM] = HWCAPS_(__VA_ARGS__, 0, 0, 0),
 
 static const HardwareCapabilities kHardwareCapabilities[] = {
     INTROSPECTION_TABLE};
 #undef LINE
+#undef HWCAPS_
 
-#define LINE(ENUM, NAME, CPUINFO_FLAG, HWCAP, HWCAP2) [ENUM] = CPUINFO_FLAG,
+#define LINE(ENUM, NAME, CPUINFO_FLAG, ...) [ENUM] = CPUINFO_FLAG,
 static const char* kCpuInfoFlags[] = {INTROSPECTION_TABLE};
 #undef LINE
@@ -23,6 +23,7 @@
 #if defined(CPU_FEATURES_MOCK_FILESYSTEM)
 // Implementation will be provided by test/filesystem_for_testing.cc.
 #elif defined(_MSC_VER)
+#include <direct.h>
 #include <io.h>
 int CpuFeatures_OpenFile(const char* filename) {
   int fd = -1;
@@ -37,7 +38,37 @@ int CpuFeatures_ReadFile(int file_descriptor, void* buffer,
   return _read(file_descriptor, buffer, (unsigned int)buffer_size);
 }
 
+int CpuFeatures_OpenFileForWriting(const char* filename) {
+  int fd = -1;
+  _sopen_s(&fd, filename, _O_WRONLY, _SH_DENYNO, _S_IWRITE);
+  return fd;
+}
+
+int CpuFeatures_WriteFile(int file_descriptor, const void* buffer,
+                          size_t buffer_size) {
+  return _write(file_descriptor, buffer, (unsigned int)buffer_size);
+}
+
+int CpuFeatures_CreateDirectory(const char* path) { return _mkdir(path); }
+
+int CpuFeatures_RemoveDirectory(const char* path) { return _rmdir(path); }
+
+CpuFeatures_Directory* CpuFeatures_OpenDirectory(const char* path) {
+  (void)path;
+  return NULL;
+}
+
+const char* CpuFeatures_ReadDirectory(CpuFeatures_Directory* directory) {
+  (void)directory;
+  return NULL;
+}
+
+void CpuFeatures_CloseDirectory(CpuFeatures_Directory* directory) {
+  (void)directory;
+}
+
 #else
+#include <dirent.h>
 #include <unistd.h>
 
 int CpuFeatures_OpenFile(const char* filename) {
@@ -59,4 +90,38 @@ int CpuFeatures_ReadFile(int file_descriptor, void* buffer,
   return result;
 }
 
+int CpuFeatures_OpenFileForWriting(const char* filename) {
+  int result;
+  do {
+    result = open(filename, O_WRONLY);
+  } while (result == -1L && errno == EINTR);
+  return result;
+}
+
+int CpuFeatures_WriteFile(int file_descriptor, const void* buffer,
+                          size_t buffer_size) {
+  int result;
+  do {
+    result = write(file_descriptor, buffer, buffer_size);
+  } while (result == -1L && errno == EINTR);
+  return result;
+}
+
+int CpuFeatures_CreateDirectory(const char* path) { return mkdir(path, 0755); }
+
+int CpuFeatures_RemoveDirectory(const char* path) { return rmdir(path); }
+
+CpuFeatures_Directory* CpuFeatures_OpenDirectory(const char* path) {
+  return (CpuFeatures_Directory*)opendir(path);
+}
+
+const char* CpuFeatures_ReadDirectory(CpuFeatures_Directory* directory) {
+  const struct dirent* const entry = readdir((DIR*)directory);
+  return entry ? entry->d_name : NULL;
+}
+
+void CpuFeatures_CloseDirectory(CpuFeatures_Directory* directory) {
+  closedir((DIR*)directory);
+}
+
 #endif
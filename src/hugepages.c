@@ -0,0 +1,206 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "internal/hugepages.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "internal/filesystem.h"
+#include "internal/stack_line_reader.h"
+#include "internal/string_view.h"
+
+void CpuFeatures_AddHugePageSize(HugePageInfo* info, int size_kb) {
+  if (info->size >= CPU_FEATURES_MAX_HUGE_PAGE_SIZES) return;
+  HugePageSize* const size = &info->sizes[info->size++];
+  size->size_kb = size_kb;
+  size->total = -1;
+  size->free = -1;
+  for (int node = 0; node < CPU_FEATURES_MAX_NUMA_NODES; ++node) {
+    size->node_total[node] = -1;
+    size->node_free[node] = -1;
+  }
+}
+
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+
+// Returns the first line of a sysfs file, empty on error. The line points into
+// `reader` and is only valid while it lives.
+static StringView ReadFirstLine(const char* filename, StackLineReader* reader) {
+  StringView line = {0};
+  const int fd = CpuFeatures_OpenFile(filename);
+  if (fd >= 0) {
+    StackLineReader_Initialize(reader, fd);
+    const LineResult result = StackLineReader_NextLine(reader);
+    if (result.full_line) line = result.line;
+    CpuFeatures_CloseFile(fd);
+  }
+  return line;
+}
+
+// Returns the number held in a sysfs file or -1 on error.
+static int ReadNumber(const char* filename) {
+  StackLineReader reader;
+  const StringView line = ReadFirstLine(filename, &reader);
+  if (line.size == 0) return -1;
+  return CpuFeatures_StringView_ParsePositiveNumber(line);
+}
+
+// The active choice of a sysfs selector is in brackets, e.g.
+// "always [madvise] never".
+static StringView GetSelectedChoice(const StringView line) {
+  const int begin = CpuFeatures_StringView_IndexOfChar(line, '[');
+  const int end = CpuFeatures_StringView_IndexOfChar(line, ']');
+  if (begin < 0 || end <= begin) return (StringView){0};
+  return view(line.ptr + begin + 1, end - begin - 1);
+}
+
+static ThpMode ReadThpMode(void) {
+  StackLineReader reader;
+  const StringView choice = GetSelectedChoice(ReadFirstLine(
+      "/sys/kernel/mm/transparent_hugepage/enabled", &reader));
+  if (CpuFeatures_StringView_IsEquals(choice, str("always")))
+    return CPU_FEATURE_THP_ALWAYS;
+  if (CpuFeatures_StringView_IsEquals(choice, str("madvise")))
+    return CPU_FEATURE_THP_MADVISE;
+  if (CpuFeatures_StringView_IsEquals(choice, str("never")))
+    return CPU_FEATURE_THP_NEVER;
+  return CPU_FEATURE_THP_UNKNOWN;
+}
+
+static ThpDefrag ReadThpDefrag(void) {
+  StackLineReader reader;
+  const StringView choice = GetSelectedChoice(
+      ReadFirstLine("/sys/kernel/mm/transparent_hugepage/defrag", &reader));
+  if (CpuFeatures_StringView_IsEquals(choice, str("always")))
+    return CPU_FEATURE_THP_DEFRAG_ALWAYS;
+  if (CpuFeatures_StringView_IsEquals(choice, str("defer")))
+    return CPU_FEATURE_THP_DEFRAG_DEFER;
+  if (CpuFeatures_StringView_IsEquals(choice, str("defer+madvise")))
+    return CPU_FEATURE_THP_DEFRAG_DEFER_MADVISE;
+  if (CpuFeatures_StringView_IsEquals(choice, str("madvise")))
+    return CPU_FEATURE_THP_DEFRAG_MADVISE;
+  if (CpuFeatures_StringView_IsEquals(choice, str("never")))
+    return CPU_FEATURE_THP_DEFRAG_NEVER;
+  return CPU_FEATURE_THP_DEFRAG_UNKNOWN;
+}
+
+// Appends the node ids of one element of a sysfs list, either "<id>" or
+// "<first>-<last>". Returns false if the element is malformed.
+static bool AddNodeRange(HugePageInfo* info, const StringView range) {
+  const int dash = CpuFeatures_StringView_IndexOfChar(range, '-');
+  const int first = CpuFeatures_StringView_ParsePositiveNumber(
+      dash < 0 ? range : CpuFeatures_StringView_KeepFront(range, dash));
+  const int last =
+      dash < 0 ? first
+               : CpuFeatures_StringView_ParsePositiveNumber(
+                     CpuFeatures_StringView_PopFront(range, dash + 1));
+  if (first < 0 || last < first) return false;
+  for (int id = first; id <= last; ++id) {
+    if (info->nodes == CPU_FEATURES_MAX_NUMA_NODES) {
+      info->nodes_truncated = 1;
+      return true;
+    }
+    info->node_ids[info->nodes++] = id;
+  }
+  return true;
+}
+
+// Node ids are sparse on some machines, the online ones are listed as
+// "0-1,4,8-9".
+static void ReadOnlineNodes(HugePageInfo* info) {
+  StackLineReader reader;
+  StringView line = CpuFeatures_StringView_TrimWhitespace(
+      ReadFirstLine("/sys/devices/system/node/online", &reader));
+  while (line.size) {
+    const int comma = CpuFeatures_StringView_IndexOfChar(line, ',');
+    const StringView range =
+        comma < 0 ? line : CpuFeatures_StringView_KeepFront(line, comma);
+    if (!AddNodeRange(info, range)) {
+      info->nodes = 0;
+      info->nodes_truncated = 0;
+      return;
+    }
+    line = comma < 0 ? (StringView){0}
+                     : CpuFeatures_StringView_PopFront(line, comma + 1);
+  }
+}
+
+// Reads the pool counters of `size`, `node` < 0 selects the global pool.
+// https://docs.kernel.org/admin-guide/mm/hugetlbpage.html
+static int ReadPool(const HugePageSize* size, int node, const char* counter) {
+  char filename[128];
+  if (node < 0)
+    snprintf(filename, sizeof(filename),
+             "/sys/kernel/mm/hugepages/hugepages-%dkB/%s", size->size_kb,
+             counter);
+  else
+    snprintf(filename, sizeof(filename),
+             "/sys/devices/system/node/node%d/hugepages/hugepages-%dkB/%s",
+             node, size->size_kb, counter);
+  return ReadNumber(filename);
+}
+
+void CpuFeatures_FillHugePageInfoFromOs(HugePageInfo* info) {
+  info->thp_enabled = ReadThpMode();
+  info->thp_defrag = ReadThpDefrag();
+  const int thp_size =
+      ReadNumber("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size");
+  if (thp_size > 0) info->thp_size_kb = thp_size / 1024;
+  ReadOnlineNodes(info);
+  for (int i = 0; i < info->size; ++i) {
+    HugePageSize* const size = &info->sizes[i];
+    size->total = ReadPool(size, -1, "nr_hugepages");
+    size->free = ReadPool(size, -1, "free_hugepages");
+    for (int node = 0; node < info->nodes; ++node) {
+      const int id = info->node_ids[node];
+      size->node_total[node] = ReadPool(size, id, "nr_hugepages");
+      size->node_free[node] = ReadPool(size, id, "free_hugepages");
+    }
+  }
+}
+
+int CpuFeatures_GetDefaultHugePageSizeFromOs(void) {
+  int size_kb = 0;
+  const int fd = CpuFeatures_OpenFile("/proc/meminfo");
+  if (fd < 0) return 0;
+  StackLineReader reader;
+  StackLineReader_Initialize(&reader, fd);
+  for (;;) {
+    const LineResult result = StackLineReader_NextLine(&reader);
+    StringView key, value;
+    if (CpuFeatures_StringView_GetAttributeKeyValue(result.line, &key,
+                                                    &value) &&
+        CpuFeatures_StringView_IsEquals(key, str("Hugepagesize"))) {
+      // The value reads "2048 kB".
+      const int space = CpuFeatures_StringView_IndexOfChar(value, ' ');
+      if (space > 0)
+        size_kb = CpuFeatures_StringView_ParsePositiveNumber(
+            CpuFeatures_StringView_KeepFront(value, space));
+      break;
+    }
+    if (result.eof) break;
+  }
+  CpuFeatures_CloseFile(fd);
+  return size_kb > 0 ? size_kb : 0;
+}
+
+#else
+
+void CpuFeatures_FillHugePageInfoFromOs(HugePageInfo* info) { (void)info; }
+
+int CpuFeatures_GetDefaultHugePageSizeFromOs(void) { return 0; }
+
+#endif  // defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
@@ -25,5 +25,7 @@ static bool IsSet(const uint64_t mask, const uint64_t value) {
 bool CpuFeatures_IsHwCapsSet(const HardwareCapabilities hwcaps_mask,
                              const HardwareCapabilities hwcaps) {
   return IsSet(hwcaps_mask.hwcaps, hwcaps.hwcaps) ||
-         IsSet(hwcaps_mask.hwcaps2, hwcaps.hwcaps2);
+         IsSet(hwcaps_mask.hwcaps2, hwcaps.hwcaps2) ||
+         IsSet(hwcaps_mask.hwcaps3, hwcaps.hwcaps3) ||
+         IsSet(hwcaps_mask.hwcaps4, hwcaps.hwcaps4);
 }
@@ -23,6 +23,8 @@
 HardwareCapabilities CpuFeatures_GetHardwareCapabilities(void);
 const char* CpuFeatures_GetPlatformPointer(void);
 const char* CpuFeatures_GetBasePlatformPointer(void);
+unsigned long CpuFeatures_GetMinSigStackSize(void);
+unsigned long CpuFeatures_GetPageSize(void);
 #else
 
 #ifdef HAVE_STRONG_ELF_AUX_INFO
@@ -30,15 +32,21 @@ const char* CpuFeatures_GetBasePlatformPointer(void);
 #include <sys/auxv.h>
 
 static unsigned long GetElfHwcapFromElfAuxInfo(int hwcap_type) {
-  unsigned long hwcap;
-  elf_aux_info(hwcap_type, &hwcap, sizeof(hwcap));
+  unsigned long hwcap = 0;
+  if (elf_aux_info(hwcap_type, &hwcap, sizeof(hwcap)) != 0) return 0;
   return hwcap;
 }
 
 HardwareCapabilities CpuFeatures_GetHardwareCapabilities(void) {
-  HardwareCapabilities capabilities;
+  HardwareCapabilities capabilities = {0};
   capabilities.hwcaps = GetElfHwcapFromElfAuxInfo(AT_HWCAP);
   capabilities.hwcaps2 = GetElfHwcapFromElfAuxInfo(AT_HWCAP2);
+#ifdef AT_HWCAP3
+  capabilities.hwcaps3 = GetElfHwcapFromElfAuxInfo(AT_HWCAP3);
+#endif
+#ifdef AT_HWCAP4
+  capabilities.hwcaps4 = GetElfHwcapFromElfAuxInfo(AT_HWCAP4);
+#endif
   return capabilities;
 }
 
@@ -46,6 +54,12 @@ const char *CpuFeatures_GetPlatformPointer(void) { return NULL; }
 
 const char *CpuFeatures_GetBasePlatformPointer(void) { return NULL; }
 
+unsigned long CpuFeatures_GetMinSigStackSize(void) { return 0; }
+
+unsigned long CpuFeatures_GetPageSize(void) {
+  return GetElfHwcapFromElfAuxInfo(AT_PAGESZ);
+}
+
 #else
 #error "FreeBSD / OpenBSD needs support for elf_aux_info"
 #endif  // HAVE_STRONG_ELF_AUX_INFO
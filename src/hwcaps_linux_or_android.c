@@ -16,6 +16,8 @@
 
 #if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -29,6 +31,8 @@
 HardwareCapabilities CpuFeatures_GetHardwareCapabilities(void);
 const char* CpuFeatures_GetPlatformPointer(void);
 const char* CpuFeatures_GetBasePlatformPointer(void);
+unsigned long CpuFeatures_GetMinSigStackSize(void);
+unsigned long CpuFeatures_GetPageSize(void);
 #else
 
 // Debug facilities
@@ -44,14 +48,14 @@ const char* CpuFeatures_GetBasePlatformPointer(void);
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////
-// Implementation of GetElfHwcapFromGetauxval
+// Implementation of GetGetauxval
 ////////////////////////////////////////////////////////////////////////////////
 
+typedef unsigned long getauxval_func_t(unsigned long);
+
 #if defined(HAVE_STRONG_GETAUXVAL)
 #include <sys/auxv.h>
-static unsigned long GetElfHwcapFromGetauxval(uint32_t hwcap_type) {
-  return getauxval(hwcap_type);
-}
+static getauxval_func_t *GetGetauxval(void) { return &getauxval; }
 #elif defined(HAVE_DLFCN_H)
 // On Android we probe the system's C library for a 'getauxval' function and
 // call it if it exits, or return 0 for failure. This function is available
@@ -64,10 +68,7 @@ static unsigned long GetElfHwcapFromGetauxval(uint32_t hwcap_type) {
 
 #include <dlfcn.h>
 
-typedef unsigned long getauxval_func_t(unsigned long);
-
-static uint32_t GetElfHwcapFromGetauxval(uint32_t hwcap_type) {
-  uint32_t ret = 0;
+static getauxval_func_t *LoadGetauxval(void) {
   void *libc_handle = NULL;
   getauxval_func_t *func = NULL;
 
@@ -75,38 +76,98 @@ static uint32_t GetElfHwcapFromGetauxval(uint32_t hwcap_type) {
   libc_handle = dlopen("libc.so", RTLD_NOW);
   if (!libc_handle) {
     D("Could not dlopen() C library: %s\n", dlerror());
-    return 0;
+    return NULL;
   }
   func = (getauxval_func_t *)dlsym(libc_handle, "getauxval");
   if (!func) {
     D("Could not find getauxval() in C library\n");
-  } else {
-    // Note: getauxval() returns 0 on failure. Doesn't touch errno.
-    ret = (uint32_t)(*func)(hwcap_type);
+    dlclose(libc_handle);
   }
-  dlclose(libc_handle);
-  return ret;
+  // On success the handle is kept open so `func` stays valid for the lifetime
+  // of the process.
+  return func;
 }
+
+// Only called while the auxiliary vector is read, which happens once per
+// process.
+static getauxval_func_t *GetGetauxval(void) { return LoadGetauxval(); }
 #else
 #error "This platform does not provide hardware capabilities."
 #endif
 
-// Implementation of GetHardwareCapabilities for OS that provide
-// GetElfHwcapFromGetauxval().
+////////////////////////////////////////////////////////////////////////////////
+// Auxiliary vector snapshot
+////////////////////////////////////////////////////////////////////////////////
 
-// Fallback when getauxval is not available, retrieves hwcaps from
-// "/proc/self/auxv".
-static uint32_t GetElfHwcapFromProcSelfAuxv(uint32_t hwcap_type) {
+// Tags may be missing from older kernel or libc headers.
+#ifndef AT_PLATFORM
+#define AT_PLATFORM 15
+#endif
+#ifndef AT_HWCAP
+#define AT_HWCAP 16
+#endif
+#ifndef AT_BASE_PLATFORM
+#define AT_BASE_PLATFORM 24
+#endif
+#ifndef AT_HWCAP2
+#define AT_HWCAP2 26
+#endif
+#ifndef AT_HWCAP3
+#define AT_HWCAP3 29
+#endif
+#ifndef AT_HWCAP4
+#define AT_HWCAP4 30
+#endif
+#ifndef AT_MINSIGSTKSZ
+#define AT_MINSIGSTKSZ 51
+#endif
+#ifndef AT_PAGESZ
+#define AT_PAGESZ 6
+#endif
+
+typedef enum {
+  AUXV_HWCAP,
+  AUXV_HWCAP2,
+  AUXV_HWCAP3,
+  AUXV_HWCAP4,
+  AUXV_PLATFORM,
+  AUXV_BASE_PLATFORM,
+  AUXV_MINSIGSTKSZ,
+  AUXV_PAGESZ,
+  AUXV_LAST_,
+} AuxvEntry;
+
+static const unsigned long kAuxvTags[AUXV_LAST_] = {
+    [AUXV_HWCAP] = AT_HWCAP,
+    [AUXV_HWCAP2] = AT_HWCAP2,
+    [AUXV_HWCAP3] = AT_HWCAP3,
+    [AUXV_HWCAP4] = AT_HWCAP4,
+    [AUXV_PLATFORM] = AT_PLATFORM,
+    [AUXV_BASE_PLATFORM] = AT_BASE_PLATFORM,
+    [AUXV_MINSIGSTKSZ] = AT_MINSIGSTKSZ,
+    [AUXV_PAGESZ] = AT_PAGESZ,
+};
+
+// Values of the auxiliary vector entries we are interested in, 0 when absent.
+typedef struct {
+  unsigned long values[AUXV_LAST_];
+} Auxv;
+
+static const Auxv kEmptyAuxv;
+
+// Fallback when getauxval is not available, retrieves all entries in a single
+// pass over "/proc/self/auxv". Entries are pairs of native words.
+static Auxv GetAuxvFromProcSelfAuxv(void) {
+  Auxv auxv = kEmptyAuxv;
   struct {
-    uint32_t tag;
-    uint32_t value;
+    unsigned long tag;
+    unsigned long value;
   } entry;
-  uint32_t result = 0;
   const char filepath[] = "/proc/self/auxv";
   const int fd = CpuFeatures_OpenFile(filepath);
   if (fd < 0) {
     D("Could not open %s\n", filepath);
-    return 0;
+    return auxv;
   }
   for (;;) {
     const int ret = CpuFeatures_ReadFile(fd, (char *)&entry, sizeof entry);
@@ -115,42 +176,89 @@ static uint32_t GetElfHwcapFromProcSelfAuxv(uint32_t hwcap_type) {
       break;
     }
     // Detect end of list.
-    if (ret == 0 || (entry.tag == 0 && entry.value == 0)) {
+    if (ret < (int)sizeof entry || (entry.tag == 0 && entry.value == 0)) {
       break;
     }
-    if (entry.tag == hwcap_type) {
-      result = entry.value;
-      break;
+    for (size_t i = 0; i < AUXV_LAST_; ++i) {
+      if (entry.tag == kAuxvTags[i]) {
+        auxv.values[i] = entry.value;
+        break;
+      }
     }
   }
   CpuFeatures_CloseFile(fd);
-  return result;
+  return auxv;
 }
 
-// Retrieves hardware capabilities by first trying to call getauxval, if not
-// available falls back to reading "/proc/self/auxv".
-static unsigned long GetHardwareCapabilitiesFor(uint32_t type) {
-  unsigned long hwcaps = GetElfHwcapFromGetauxval(type);
-  if (!hwcaps) {
-    D("Parsing /proc/self/auxv to extract ELF hwcaps!\n");
-    hwcaps = GetElfHwcapFromProcSelfAuxv(type);
+// Retrieves the auxiliary vector entries by first trying to call getauxval, if
+// not available or if it does not report AT_HWCAP, falls back to reading
+// "/proc/self/auxv".
+static Auxv ReadAuxv(void) {
+  getauxval_func_t *const func = GetGetauxval();
+  if (func) {
+    // Note: getauxval() returns 0 on failure. Doesn't touch errno.
+    Auxv auxv = kEmptyAuxv;
+    for (size_t i = 0; i < AUXV_LAST_; ++i) {
+      auxv.values[i] = func(kAuxvTags[i]);
+    }
+    if (auxv.values[AUXV_HWCAP]) return auxv;
   }
-  return hwcaps;
+  D("Parsing /proc/self/auxv to extract ELF hwcaps!\n");
+  return GetAuxvFromProcSelfAuxv();
 }
 
+#if defined(CPU_FEATURES_COMPILER_CLANG) || defined(CPU_FEATURES_COMPILER_GCC)
+#define AUXV_CACHE_EMPTY 0
+#define AUXV_CACHE_WRITING 1
+#define AUXV_CACHE_READY 2
+
+static int g_auxv_state = AUXV_CACHE_EMPTY;
+static Auxv g_auxv;
+
+// The auxiliary vector does not change during the lifetime of the process. The
+// first caller reads and publishes it, threads racing with it read their own
+// copy.
+static Auxv GetAuxv(void) {
+  int state = __atomic_load_n(&g_auxv_state, __ATOMIC_ACQUIRE);
+  if (state == AUXV_CACHE_READY) return g_auxv;
+  const Auxv auxv = ReadAuxv();
+  if (state == AUXV_CACHE_EMPTY &&
+      __atomic_compare_exchange_n(&g_auxv_state, &state, AUXV_CACHE_WRITING,
+                                  false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+    g_auxv = auxv;
+    __atomic_store_n(&g_auxv_state, AUXV_CACHE_READY, __ATOMIC_RELEASE);
+  }
+  return auxv;
+}
+#else
+// Without GNU atomics the auxiliary vector is read on every call.
+static Auxv GetAuxv(void) { return ReadAuxv(); }
+#endif
+
 HardwareCapabilities CpuFeatures_GetHardwareCapabilities(void) {
+  const Auxv auxv = GetAuxv();
   HardwareCapabilities capabilities;
-  capabilities.hwcaps = GetHardwareCapabilitiesFor(AT_HWCAP);
-  capabilities.hwcaps2 = GetHardwareCapabilitiesFor(AT_HWCAP2);
+  capabilities.hwcaps = auxv.values[AUXV_HWCAP];
+  capabilities.hwcaps2 = auxv.values[AUXV_HWCAP2];
+  capabilities.hwcaps3 = auxv.values[AUXV_HWCAP3];
+  capabilities.hwcaps4 = auxv.values[AUXV_HWCAP4];
   return capabilities;
 }
 
 const char *CpuFeatures_GetPlatformPointer(void) {
-  return (const char *)GetHardwareCapabilitiesFor(AT_PLATFORM);
+  return (const char *)GetAuxv().values[AUXV_PLATFORM];
 }
 
 const char *CpuFeatures_GetBasePlatformPointer(void) {
-  return (const char *)GetHardwareCapabilitiesFor(AT_BASE_PLATFORM);
+  return (const char *)GetAuxv().values[AUXV_BASE_PLATFORM];
+}
+
+unsigned long CpuFeatures_GetMinSigStackSize(void) {
+  return GetAuxv().values[AUXV_MINSIGSTKSZ];
+}
+
+unsigned long CpuFeatures_GetPageSize(void) {
+  return GetAuxv().values[AUXV_PAGESZ];
 }
 
 #endif  // CPU_FEATURES_TEST
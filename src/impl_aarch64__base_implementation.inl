@@ -18,6 +18,7 @@
 #include "cpuinfo_aarch64.h"
 #include "internal/bit_utils.h"
 #include "internal/filesystem.h"
+#include "internal/hugepages.h"
 #include "internal/stack_line_reader.h"
 #include "internal/string_view.h"
 
@@ -138,8 +139,77 @@
        AARCH64_HWCAP2_SME_SF8DP4)                                            \
   LINE(AARCH64_SME_SF8DP2, smesf8dp2, "smesf8dp2", 0,                        \
        AARCH64_HWCAP2_SME_SF8DP2)                                            \
-  LINE(AARCH64_POE, poe, "poe", 0, AARCH64_HWCAP2_POE)
+  LINE(AARCH64_POE, poe, "poe", 0, AARCH64_HWCAP2_POE)                       \
+  LINE(AARCH64_MTE_FAR, mtefar, "mtefar", 0, 0, AARCH64_HWCAP3_MTE_FAR)      \
+  LINE(AARCH64_MTE_STORE_ONLY, mtestoreonly, "mtestoreonly", 0, 0,           \
+       AARCH64_HWCAP3_MTE_STORE_ONLY)
 
 #define INTROSPECTION_PREFIX Aarch64
 #define INTROSPECTION_ENUM_PREFIX AARCH64
 #include "define_introspection_and_hwcaps.inl"
+
+CryptoFeatures GetAarch64CryptoFeatures(const Aarch64Features* features) {
+  return (CryptoFeatures){
+      .aes = features->aes,
+      .clmul = features->pmull,
+      .sha1 = features->sha1,
+      .sha256 = features->sha2,
+      .sha512 = features->sha512,
+      .sha3 = features->sha3,
+      .sm3 = features->sm3,
+      .sm4 = features->sm4,
+  };
+}
+
+// This function has to be implemented by the OS.
+static int GetPageSizeFromOs(void);
+
+// The huge page sizes depend on the translation granule.
+// https://docs.kernel.org/arch/arm64/hugetlbpage.html
+HugePageInfo GetAarch64HugePageInfo(void) {
+  HugePageInfo info = {.page_size = GetPageSizeFromOs()};
+  switch (info.page_size) {
+    case 4 * 1024:
+      CpuFeatures_AddHugePageSize(&info, 64);
+      CpuFeatures_AddHugePageSize(&info, 2 * 1024);
+      CpuFeatures_AddHugePageSize(&info, 32 * 1024);
+      CpuFeatures_AddHugePageSize(&info, 1024 * 1024);
+      break;
+    case 16 * 1024:
+      CpuFeatures_AddHugePageSize(&info, 2 * 1024);
+      CpuFeatures_AddHugePageSize(&info, 32 * 1024);
+      CpuFeatures_AddHugePageSize(&info, 1024 * 1024);
+      break;
+    case 64 * 1024:
+      CpuFeatures_AddHugePageSize(&info, 2 * 1024);
+      CpuFeatures_AddHugePageSize(&info, 512 * 1024);
+      CpuFeatures_AddHugePageSize(&info, 16 * 1024 * 1024);
+      break;
+  }
+  CpuFeatures_FillHugePageInfoFromOs(&info);
+  return info;
+}
+
+// This function has to be implemented by the OS.
+static void GetTaggedAddressControlFromOs(Aarch64TaggedAddressControl* info);
+
+Aarch64TaggedAddressControl GetAarch64TaggedAddressControl(void) {
+  Aarch64TaggedAddressControl info = {
+      .tagged_addr_enabled = -1,
+      .mte_tcf_sync = -1,
+      .mte_tcf_async = -1,
+      .mte_tag_mask = -1,
+  };
+  GetTaggedAddressControlFromOs(&info);
+  return info;
+}
+
+// This function has to be implemented by the OS.
+static void GetProtectionKeysFromOs(ProtectionKeys* info);
+
+ProtectionKeys GetAarch64ProtectionKeys(void) {
+  ProtectionKeys info = {.supported = GetAarch64Features().poe,
+                         .num_keys = -1};
+  if (info.supported) GetProtectionKeysFromOs(&info);
+  return info;
+}
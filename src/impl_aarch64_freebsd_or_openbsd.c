@@ -42,5 +42,28 @@ Aarch64Info GetAarch64Info(void) {
   return info;
 }
 
+Aarch64Features GetAarch64Features(void) {
+  Aarch64Features features = kEmptyAarch64Info.features;
+  const HardwareCapabilities hwcaps = CpuFeatures_GetHardwareCapabilities();
+  for (size_t i = 0; i < AARCH64_LAST_; ++i) {
+    if (CpuFeatures_IsHwCapsSet(kHardwareCapabilities[i], hwcaps)) {
+      kSetters[i](&features, true);
+    }
+  }
+  return features;
+}
+
+static int GetPageSizeFromOs(void) { return (int)CpuFeatures_GetPageSize(); }
+
+static void GetTaggedAddressControlFromOs(Aarch64TaggedAddressControl* info) {
+  (void)info;
+  // The tagged address ABI is Linux specific.
+}
+
+static void GetProtectionKeysFromOs(ProtectionKeys* info) {
+  (void)info;
+  // pkey_alloc is Linux specific.
+}
+
 #endif  // CPU_FEATURES_OS_FREEBSD || CPU_FEATURES_OS_OPENBSD
 #endif  // CPU_FEATURES_ARCH_AARCH64
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+// For syscall().
+#define _GNU_SOURCE
+
 #include "cpu_features_macros.h"
 
 #ifdef CPU_FEATURES_ARCH_AARCH64
@@ -56,6 +59,15 @@ static void FillProcCpuInfoData(Aarch64Info* const info) {
   }
 }
 
+static void FillHwCapsData(const HardwareCapabilities hwcaps,
+                           Aarch64Features* const features) {
+  for (size_t i = 0; i < AARCH64_LAST_; ++i) {
+    if (CpuFeatures_IsHwCapsSet(kHardwareCapabilities[i], hwcaps)) {
+      kSetters[i](features, true);
+    }
+  }
+}
+
 static const Aarch64Info kEmptyAarch64Info;
 
 Aarch64Info GetAarch64Info(void) {
@@ -65,14 +77,91 @@ Aarch64Info GetAarch64Info(void) {
   Aarch64Info info = kEmptyAarch64Info;
 
   FillProcCpuInfoData(&info);
+  FillHwCapsData(CpuFeatures_GetHardwareCapabilities(), &info.features);
+
+  return info;
+}
+
+Aarch64Features GetAarch64Features(void) {
+  // Every feature in the introspection table maps to a hwcap bit so
+  // /proc/cpuinfo is only needed when the kernel did not provide any.
   const HardwareCapabilities hwcaps = CpuFeatures_GetHardwareCapabilities();
-  for (size_t i = 0; i < AARCH64_LAST_; ++i) {
-    if (CpuFeatures_IsHwCapsSet(kHardwareCapabilities[i], hwcaps)) {
-      kSetters[i](&info.features, true);
-    }
+  if (hwcaps.hwcaps == 0 && hwcaps.hwcaps2 == 0) {
+    return GetAarch64Info().features;
   }
+  Aarch64Features features = kEmptyAarch64Info.features;
+  FillHwCapsData(hwcaps, &features);
+  return features;
+}
 
-  return info;
+static int GetPageSizeFromOs(void) { return (int)CpuFeatures_GetPageSize(); }
+
+#if defined(CPU_FEATURES_MOCK_CPUID_AARCH64)
+extern long LinuxPrctl(int option);
+extern int LinuxPkeyAlloc(unsigned int access_rights);
+extern int LinuxPkeyFree(int pkey);
+#else  // CPU_FEATURES_MOCK_CPUID_AARCH64
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static long LinuxPrctl(int option) { return prctl(option, 0, 0, 0, 0); }
+
+static int LinuxPkeyAlloc(unsigned int access_rights) {
+#if defined(SYS_pkey_alloc)
+  return (int)syscall(SYS_pkey_alloc, 0, access_rights);
+#else
+  (void)access_rights;
+  return -1;
+#endif
+}
+
+static int LinuxPkeyFree(int pkey) {
+#if defined(SYS_pkey_free)
+  return (int)syscall(SYS_pkey_free, pkey);
+#else
+  (void)pkey;
+  return -1;
+#endif
+}
+#endif  // CPU_FEATURES_MOCK_CPUID_AARCH64
+
+// From include/uapi/linux/prctl.h
+#define PR_GET_TAGGED_ADDR_CTRL 56
+#define PR_TAGGED_ADDR_ENABLE (1UL << 0)
+#define PR_MTE_TCF_SYNC (1UL << 1)
+#define PR_MTE_TCF_ASYNC (1UL << 2)
+#define PR_MTE_TAG_SHIFT 3
+
+static void GetTaggedAddressControlFromOs(Aarch64TaggedAddressControl* info) {
+  // Available since Linux 5.4, fails when the ABI is disabled through the
+  // abi.tagged_addr_disabled sysctl.
+  const long ctrl = LinuxPrctl(PR_GET_TAGGED_ADDR_CTRL);
+  if (ctrl < 0) return;
+  info->tagged_addr_enabled = (ctrl & PR_TAGGED_ADDR_ENABLE) != 0;
+  info->mte_tcf_sync = (ctrl & PR_MTE_TCF_SYNC) != 0;
+  info->mte_tcf_async = (ctrl & PR_MTE_TCF_ASYNC) != 0;
+  info->mte_tag_mask = (int)((unsigned long)ctrl >> PR_MTE_TAG_SHIFT) & 0xFFFF;
+}
+
+// From include/uapi/asm-generic/mman-common.h
+#define PKEY_DISABLE_ACCESS 0x1
+
+// POE has 8 overlay indices, index 0 is the default one.
+#define MAX_PKEYS 8
+
+static void GetProtectionKeysFromOs(ProtectionKeys* info) {
+  // Available since Linux 6.12. The keys are counted by allocating all of them
+  // and giving them back. pkey_free leaves the thread's rights untouched, the
+  // keys are allocated without access which is what the kernel gives threads
+  // for keys they did not allocate.
+  int pkeys[MAX_PKEYS];
+  int count = 0;
+  while (count < MAX_PKEYS &&
+         (pkeys[count] = LinuxPkeyAlloc(PKEY_DISABLE_ACCESS)) >= 0)
+    ++count;
+  for (int i = 0; i < count; ++i) LinuxPkeyFree(pkeys[i]);
+  info->num_keys = count;
 }
 
 #endif  // defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
@@ -86,5 +86,21 @@ Aarch64Info GetAarch64Info(void) {
   return info;
 }
 
+Aarch64Features GetAarch64Features(void) { return GetAarch64Info().features; }
+
+static int GetPageSizeFromOs(void) {
+  return GetDarwinSysCtlByNameValue("hw.pagesize");
+}
+
+static void GetTaggedAddressControlFromOs(Aarch64TaggedAddressControl* info) {
+  (void)info;
+  // The tagged address ABI is Linux specific.
+}
+
+static void GetProtectionKeysFromOs(ProtectionKeys* info) {
+  (void)info;
+  // pkey_alloc is Linux specific.
+}
+
 #endif  // defined(CPU_FEATURES_OS_MACOS) || defined(CPU_FEATURES_OS_IPHONE)
 #endif  // CPU_FEATURES_ARCH_AARCH64
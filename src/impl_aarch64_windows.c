@@ -67,5 +67,20 @@ Aarch64Info GetAarch64Info(void) {
   return info;
 }
 
+Aarch64Features GetAarch64Features(void) { return GetAarch64Info().features; }
+
+// Windows on Arm always uses 4 KiB pages.
+static int GetPageSizeFromOs(void) { return 4096; }
+
+static void GetTaggedAddressControlFromOs(Aarch64TaggedAddressControl* info) {
+  (void)info;
+  // The tagged address ABI is Linux specific.
+}
+
+static void GetProtectionKeysFromOs(ProtectionKeys* info) {
+  (void)info;
+  // pkey_alloc is Linux specific.
+}
+
 #endif  // CPU_FEATURES_OS_WINDOWS
 #endif  // CPU_FEATURES_ARCH_AARCH64
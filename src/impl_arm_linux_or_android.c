@@ -184,6 +184,27 @@ static void FillProcCpuInfoData(ArmInfo* const info,
   }
 }
 
+static void FillHwCapsData(const HardwareCapabilities hwcaps,
+                           ArmFeatures* const features) {
+  for (size_t i = 0; i < ARM_LAST_; ++i) {
+    if (CpuFeatures_IsHwCapsSet(kHardwareCapabilities[i], hwcaps)) {
+      kSetters[i](features, true);
+    }
+  }
+}
+
+// The kernel bugs worked around in FixErrors only affect ARMv7 cores that
+// either miss IDIV or report NEON. When the platform is known to be ARMv8 or
+// when none of these conditions hold, /proc/cpuinfo brings nothing more than
+// the hardware capabilities.
+static bool MayNeedProcCpuInfoFixes(const ArmFeatures* const features) {
+  const char* const platform = CpuFeatures_GetPlatformPointer();
+  if (platform && CpuFeatures_StringView_StartsWith(str(platform), str("v8"))) {
+    return false;
+  }
+  return features->neon || !features->idiva || !features->idivt;
+}
+
 static const ArmInfo kEmptyArmInfo;
 
 static const ProcCpuInfoData kEmptyProcCpuInfoData;
@@ -196,17 +217,28 @@ ArmInfo GetArmInfo(void) {
   ProcCpuInfoData proc_cpu_info_data = kEmptyProcCpuInfoData;
 
   FillProcCpuInfoData(&info, &proc_cpu_info_data);
-  const HardwareCapabilities hwcaps = CpuFeatures_GetHardwareCapabilities();
-  for (size_t i = 0; i < ARM_LAST_; ++i) {
-    if (CpuFeatures_IsHwCapsSet(kHardwareCapabilities[i], hwcaps)) {
-      kSetters[i](&info.features, true);
-    }
-  }
+  FillHwCapsData(CpuFeatures_GetHardwareCapabilities(), &info.features);
 
   FixErrors(&info, &proc_cpu_info_data);
 
   return info;
 }
 
+ArmFeatures GetArmFeatures(void) {
+  const HardwareCapabilities hwcaps = CpuFeatures_GetHardwareCapabilities();
+  if (hwcaps.hwcaps == 0 && hwcaps.hwcaps2 == 0) {
+    return GetArmInfo().features;
+  }
+  ArmInfo info = kEmptyArmInfo;
+  FillHwCapsData(hwcaps, &info.features);
+  if (MayNeedProcCpuInfoFixes(&info.features)) {
+    return GetArmInfo().features;
+  }
+  // Only feature propagation applies here.
+  ProcCpuInfoData proc_cpu_info_data = kEmptyProcCpuInfoData;
+  FixErrors(&info, &proc_cpu_info_data);
+  return info.features;
+}
+
 #endif  // defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
 #endif  // CPU_FEATURES_ARCH_ARM
@@ -0,0 +1,41 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "cpu_features_macros.h"
+
+#ifdef CPU_FEATURES_ARCH_RISCV
+#if defined(CPU_FEATURES_OS_LINUX)
+#if (defined(CPU_FEATURES_COMPILER_GCC) || defined(CPU_FEATURES_COMPILER_CLANG))
+
+#include "internal/cpuid_riscv.h"
+
+#ifdef CPU_FEATURES_MOCK_CPUID_RISCV
+// Implementation will be provided by test/cpuinfo_riscv_test.cc.
+#else
+uint64_t GetRiscvVlenb(void) {
+  unsigned long vlenb;
+  // The CSR is referred to by number (vlenb is 0xc22) so that this file builds
+  // without the V extension enabled in -march.
+  __asm__ volatile("csrr %0, 0xc22" : "=r"(vlenb));
+  return vlenb;
+}
+#endif  // CPU_FEATURES_MOCK_CPUID_RISCV
+
+#else
+#error "Unsupported compiler, riscv cpuid requires either GCC or Clang."
+#endif  // (defined(CPU_FEATURES_COMPILER_GCC) ||
+        // defined(CPU_FEATURES_COMPILER_CLANG))
+#endif  // defined(CPU_FEATURES_OS_LINUX)
+#endif  // CPU_FEATURES_ARCH_RISCV
@@ -0,0 +1,47 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// For syscall().
+#define _GNU_SOURCE
+
+#include "cpu_features_macros.h"
+
+#ifdef CPU_FEATURES_ARCH_RISCV
+#if defined(CPU_FEATURES_OS_LINUX)
+
+#include "internal/hwprobe_riscv.h"
+
+#ifdef CPU_FEATURES_MOCK_HWPROBE_RISCV
+// Implementation will be provided by test/cpuinfo_riscv_test.cc.
+#else
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef __NR_riscv_hwprobe
+#define __NR_riscv_hwprobe 258
+#endif
+
+int GetRiscvHwprobe(RiscvHwprobePair* pairs, size_t pair_count) {
+  // Passing no cpu set queries the values common to all online CPUs.
+  return (int)syscall(__NR_riscv_hwprobe, pairs, pair_count, 0, NULL, 0);
+}
+
+long GetRiscvVectorControl(void) {
+  return prctl(PR_RISCV_V_GET_CONTROL, 0, 0, 0, 0);
+}
+#endif  // CPU_FEATURES_MOCK_HWPROBE_RISCV
+
+#endif  // defined(CPU_FEATURES_OS_LINUX)
+#endif  // CPU_FEATURES_ARCH_RISCV
@@ -24,24 +24,77 @@
 // isa string should match the following regex
 // ^rv(?:64|32)imaf?d?q?c?b?v?k?h?(?:_[hsxz](?:[a-z])+)*$
 //
-// This means we can test for features in this exact order except for Z
-// extensions.
+// In practice single letter extensions may carry a version (e.g. "i2p0") and
+// the underscore separated multi-letter extensions come in any order, so the
+// string is tokenized rather than matched in table order.
 
 ////////////////////////////////////////////////////////////////////////////////
 // Definitions for introspection.
 ////////////////////////////////////////////////////////////////////////////////
-#define INTROSPECTION_TABLE                            \
-  LINE(RISCV_RV32I, RV32I, "rv32i", RISCV_HWCAP_32, 0) \
-  LINE(RISCV_RV64I, RV64I, "rv64i", RISCV_HWCAP_64, 0) \
-  LINE(RISCV_M, M, "m", RISCV_HWCAP_M, 0)              \
-  LINE(RISCV_A, A, "a", RISCV_HWCAP_A, 0)              \
-  LINE(RISCV_F, F, "f", RISCV_HWCAP_F, 0)              \
-  LINE(RISCV_D, D, "d", RISCV_HWCAP_D, 0)              \
-  LINE(RISCV_Q, Q, "q", RISCV_HWCAP_Q, 0)              \
-  LINE(RISCV_C, C, "c", RISCV_HWCAP_C, 0)              \
-  LINE(RISCV_V, V, "v", RISCV_HWCAP_V, 0)              \
-  LINE(RISCV_Zicsr, Zicsr, "_zicsr", 0, 0)             \
-  LINE(RISCV_Zifencei, Zifencei, "_zifencei", 0, 0)
+#define INTROSPECTION_TABLE                                       \
+  LINE(RISCV_RV32I, RV32I, "rv32i", RISCV_HWCAP_32, 0)            \
+  LINE(RISCV_RV64I, RV64I, "rv64i", RISCV_HWCAP_64, 0)            \
+  LINE(RISCV_M, M, "m", RISCV_HWCAP_M, 0)                         \
+  LINE(RISCV_A, A, "a", RISCV_HWCAP_A, 0)                         \
+  LINE(RISCV_F, F, "f", RISCV_HWCAP_F, 0)                         \
+  LINE(RISCV_D, D, "d", RISCV_HWCAP_D, 0)                         \
+  LINE(RISCV_Q, Q, "q", RISCV_HWCAP_Q, 0)                         \
+  LINE(RISCV_C, C, "c", RISCV_HWCAP_C, 0)                         \
+  LINE(RISCV_V, V, "v", RISCV_HWCAP_V, 0)                         \
+  LINE(RISCV_Zicsr, Zicsr, "zicsr", 0, 0)                         \
+  LINE(RISCV_Zifencei, Zifencei, "zifencei", 0, 0)                \
+  LINE(RISCV_Zicbom, Zicbom, "zicbom", 0, 0)                      \
+  LINE(RISCV_Zicboz, Zicboz, "zicboz", 0, 0)                      \
+  LINE(RISCV_Zicond, Zicond, "zicond", 0, 0)                      \
+  LINE(RISCV_Zihintntl, Zihintntl, "zihintntl", 0, 0)             \
+  LINE(RISCV_Zihintpause, Zihintpause, "zihintpause", 0, 0)       \
+  LINE(RISCV_Zawrs, Zawrs, "zawrs", 0, 0)                         \
+  LINE(RISCV_Zacas, Zacas, "zacas", 0, 0)                         \
+  LINE(RISCV_Ztso, Ztso, "ztso", 0, 0)                            \
+  LINE(RISCV_Zfa, Zfa, "zfa", 0, 0)                               \
+  LINE(RISCV_Zfh, Zfh, "zfh", 0, 0)                               \
+  LINE(RISCV_Zfhmin, Zfhmin, "zfhmin", 0, 0)                      \
+  LINE(RISCV_Zba, Zba, "zba", 0, 0)                               \
+  LINE(RISCV_Zbb, Zbb, "zbb", 0, 0)                               \
+  LINE(RISCV_Zbc, Zbc, "zbc", 0, 0)                               \
+  LINE(RISCV_Zbs, Zbs, "zbs", 0, 0)                               \
+  LINE(RISCV_Zbkb, Zbkb, "zbkb", 0, 0)                            \
+  LINE(RISCV_Zbkc, Zbkc, "zbkc", 0, 0)                            \
+  LINE(RISCV_Zbkx, Zbkx, "zbkx", 0, 0)                            \
+  LINE(RISCV_Zknd, Zknd, "zknd", 0, 0)                            \
+  LINE(RISCV_Zkne, Zkne, "zkne", 0, 0)                            \
+  LINE(RISCV_Zknh, Zknh, "zknh", 0, 0)                            \
+  LINE(RISCV_Zksed, Zksed, "zksed", 0, 0)                         \
+  LINE(RISCV_Zksh, Zksh, "zksh", 0, 0)                            \
+  LINE(RISCV_Zkt, Zkt, "zkt", 0, 0)                               \
+  LINE(RISCV_Zvbb, Zvbb, "zvbb", 0, 0)                            \
+  LINE(RISCV_Zvbc, Zvbc, "zvbc", 0, 0)                            \
+  LINE(RISCV_Zvkb, Zvkb, "zvkb", 0, 0)                            \
+  LINE(RISCV_Zvkg, Zvkg, "zvkg", 0, 0)                            \
+  LINE(RISCV_Zvkned, Zvkned, "zvkned", 0, 0)                      \
+  LINE(RISCV_Zvknha, Zvknha, "zvknha", 0, 0)                      \
+  LINE(RISCV_Zvknhb, Zvknhb, "zvknhb", 0, 0)                      \
+  LINE(RISCV_Zvksed, Zvksed, "zvksed", 0, 0)                      \
+  LINE(RISCV_Zvksh, Zvksh, "zvksh", 0, 0)                         \
+  LINE(RISCV_Zvkt, Zvkt, "zvkt", 0, 0)                            \
+  LINE(RISCV_Zvfh, Zvfh, "zvfh", 0, 0)                            \
+  LINE(RISCV_Zvfhmin, Zvfhmin, "zvfhmin", 0, 0)                   \
+  LINE(RISCV_Zve32x, Zve32x, "zve32x", 0, 0)                      \
+  LINE(RISCV_Zve32f, Zve32f, "zve32f", 0, 0)                      \
+  LINE(RISCV_Zve64x, Zve64x, "zve64x", 0, 0)                      \
+  LINE(RISCV_Zve64f, Zve64f, "zve64f", 0, 0)                      \
+  LINE(RISCV_Zve64d, Zve64d, "zve64d", 0, 0)                      \
+  LINE(RISCV_Zvl32b, Zvl32b, "zvl32b", 0, 0)                      \
+  LINE(RISCV_Zvl64b, Zvl64b, "zvl64b", 0, 0)                      \
+  LINE(RISCV_Zvl128b, Zvl128b, "zvl128b", 0, 0)                   \
+  LINE(RISCV_Zvl256b, Zvl256b, "zvl256b", 0, 0)                   \
+  LINE(RISCV_Zvl512b, Zvl512b, "zvl512b", 0, 0)                   \
+  LINE(RISCV_Zvl1024b, Zvl1024b, "zvl1024b", 0, 0)                \
+  LINE(RISCV_XTheadBa, XTheadBa, "xtheadba", 0, 0)                \
+  LINE(RISCV_XTheadBb, XTheadBb, "xtheadbb", 0, 0)                \
+  LINE(RISCV_XTheadBs, XTheadBs, "xtheadbs", 0, 0)                \
+  LINE(RISCV_XTheadCondMov, XTheadCondMov, "xtheadcondmov", 0, 0) \
+  LINE(RISCV_XTheadVector, XTheadVector, "xtheadvector", 0, 0)
 #define INTROSPECTION_PREFIX Riscv
 #define INTROSPECTION_ENUM_PREFIX RISCV
 #include "define_introspection_and_hwcaps.inl"
@@ -52,20 +105,222 @@
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
+#include "internal/cpuid_riscv.h"
 #include "internal/filesystem.h"
+#include "internal/hwprobe_riscv.h"
 #include "internal/stack_line_reader.h"
 
 static const RiscvInfo kEmptyRiscvInfo;
+static const RiscvVectorInfo kEmptyRiscvVectorInfo;
+
+typedef enum {
+  HWPROBE_BASE_BEHAVIOR,
+  HWPROBE_IMA_EXT_0,
+  HWPROBE_CPUPERF_0,
+  HWPROBE_MISALIGNED_SCALAR_PERF,
+  HWPROBE_ZICBOZ_BLOCK_SIZE,
+  HWPROBE_VENDOR_EXT_THEAD_0,
+  HWPROBE_LAST_,
+} HwprobeEntry;
+
+// Features reported in RISCV_HWPROBE_KEY_IMA_EXT_0, except for F and D which
+// share a single bit.
+static const struct {
+  uint64_t mask;
+  RiscvFeaturesEnum feature;
+} kHwprobeImaExt0[] = {
+    {RISCV_HWPROBE_IMA_C, RISCV_C},
+    {RISCV_HWPROBE_IMA_V, RISCV_V},
+    {RISCV_HWPROBE_EXT_ZICBOM, RISCV_Zicbom},
+    {RISCV_HWPROBE_EXT_ZICBOZ, RISCV_Zicboz},
+    {RISCV_HWPROBE_EXT_ZICOND, RISCV_Zicond},
+    {RISCV_HWPROBE_EXT_ZIHINTNTL, RISCV_Zihintntl},
+    {RISCV_HWPROBE_EXT_ZIHINTPAUSE, RISCV_Zihintpause},
+    {RISCV_HWPROBE_EXT_ZAWRS, RISCV_Zawrs},
+    {RISCV_HWPROBE_EXT_ZACAS, RISCV_Zacas},
+    {RISCV_HWPROBE_EXT_ZTSO, RISCV_Ztso},
+    {RISCV_HWPROBE_EXT_ZFA, RISCV_Zfa},
+    {RISCV_HWPROBE_EXT_ZFH, RISCV_Zfh},
+    {RISCV_HWPROBE_EXT_ZFHMIN, RISCV_Zfhmin},
+    {RISCV_HWPROBE_EXT_ZBA, RISCV_Zba},
+    {RISCV_HWPROBE_EXT_ZBB, RISCV_Zbb},
+    {RISCV_HWPROBE_EXT_ZBC, RISCV_Zbc},
+    {RISCV_HWPROBE_EXT_ZBS, RISCV_Zbs},
+    {RISCV_HWPROBE_EXT_ZBKB, RISCV_Zbkb},
+    {RISCV_HWPROBE_EXT_ZBKC, RISCV_Zbkc},
+    {RISCV_HWPROBE_EXT_ZBKX, RISCV_Zbkx},
+    {RISCV_HWPROBE_EXT_ZKND, RISCV_Zknd},
+    {RISCV_HWPROBE_EXT_ZKNE, RISCV_Zkne},
+    {RISCV_HWPROBE_EXT_ZKNH, RISCV_Zknh},
+    {RISCV_HWPROBE_EXT_ZKSED, RISCV_Zksed},
+    {RISCV_HWPROBE_EXT_ZKSH, RISCV_Zksh},
+    {RISCV_HWPROBE_EXT_ZKT, RISCV_Zkt},
+    {RISCV_HWPROBE_EXT_ZVBB, RISCV_Zvbb},
+    {RISCV_HWPROBE_EXT_ZVBC, RISCV_Zvbc},
+    {RISCV_HWPROBE_EXT_ZVKB, RISCV_Zvkb},
+    {RISCV_HWPROBE_EXT_ZVKG, RISCV_Zvkg},
+    {RISCV_HWPROBE_EXT_ZVKNED, RISCV_Zvkned},
+    {RISCV_HWPROBE_EXT_ZVKNHA, RISCV_Zvknha},
+    {RISCV_HWPROBE_EXT_ZVKNHB, RISCV_Zvknhb},
+    {RISCV_HWPROBE_EXT_ZVKSED, RISCV_Zvksed},
+    {RISCV_HWPROBE_EXT_ZVKSH, RISCV_Zvksh},
+    {RISCV_HWPROBE_EXT_ZVKT, RISCV_Zvkt},
+    {RISCV_HWPROBE_EXT_ZVFH, RISCV_Zvfh},
+    {RISCV_HWPROBE_EXT_ZVFHMIN, RISCV_Zvfhmin},
+    {RISCV_HWPROBE_EXT_ZVE32X, RISCV_Zve32x},
+    {RISCV_HWPROBE_EXT_ZVE32F, RISCV_Zve32f},
+    {RISCV_HWPROBE_EXT_ZVE64X, RISCV_Zve64x},
+    {RISCV_HWPROBE_EXT_ZVE64F, RISCV_Zve64f},
+    {RISCV_HWPROBE_EXT_ZVE64D, RISCV_Zve64d},
+};
+
+static bool IsKeyKnown(const RiscvHwprobePair pair) { return pair.key != -1; }
+
+// Fills features from the riscv_hwprobe syscall, returns false if the syscall
+// is not available in which case /proc/cpuinfo has to be parsed.
+static bool FillHwprobeData(RiscvInfo* const info) {
+  RiscvHwprobePair pairs[HWPROBE_LAST_] = {
+      [HWPROBE_BASE_BEHAVIOR] = {RISCV_HWPROBE_KEY_BASE_BEHAVIOR, 0},
+      [HWPROBE_IMA_EXT_0] = {RISCV_HWPROBE_KEY_IMA_EXT_0, 0},
+      [HWPROBE_CPUPERF_0] = {RISCV_HWPROBE_KEY_CPUPERF_0, 0},
+      [HWPROBE_MISALIGNED_SCALAR_PERF] =
+          {RISCV_HWPROBE_KEY_MISALIGNED_SCALAR_PERF, 0},
+      [HWPROBE_ZICBOZ_BLOCK_SIZE] = {RISCV_HWPROBE_KEY_ZICBOZ_BLOCK_SIZE, 0},
+      [HWPROBE_VENDOR_EXT_THEAD_0] = {RISCV_HWPROBE_KEY_VENDOR_EXT_THEAD_0, 0},
+  };
+  if (GetRiscvHwprobe(pairs, HWPROBE_LAST_) != 0) return false;
+  const RiscvHwprobePair base = pairs[HWPROBE_BASE_BEHAVIOR];
+  if (!IsKeyKnown(base) || !(base.value & RISCV_HWPROBE_BASE_BEHAVIOR_IMA)) {
+    return false;
+  }
+  RiscvFeatures* const features = &info->features;
+#if defined(CPU_FEATURES_ARCH_RISCV32)
+  features->RV32I = true;
+#else
+  features->RV64I = true;
+#endif
+  // The IMA base behavior follows the 2.2 user ISA which includes Zicsr and
+  // Zifencei.
+  features->M = true;
+  features->A = true;
+  features->Zicsr = true;
+  features->Zifencei = true;
+  const uint64_t ima_ext_0 = pairs[HWPROBE_IMA_EXT_0].value;
+  features->F = features->D = (ima_ext_0 & RISCV_HWPROBE_IMA_FD) != 0;
+  for (size_t i = 0; i < sizeof(kHwprobeImaExt0) / sizeof(kHwprobeImaExt0[0]);
+       ++i) {
+    if (ima_ext_0 & kHwprobeImaExt0[i].mask) {
+      kSetters[kHwprobeImaExt0[i].feature](features, true);
+    }
+  }
+
+  // RISCV_HWPROBE_KEY_MISALIGNED_SCALAR_PERF supersedes the now deprecated
+  // RISCV_HWPROBE_KEY_CPUPERF_0 since Linux 6.11, both share the same values.
+  const RiscvHwprobePair misaligned =
+      IsKeyKnown(pairs[HWPROBE_MISALIGNED_SCALAR_PERF])
+          ? pairs[HWPROBE_MISALIGNED_SCALAR_PERF]
+          : pairs[HWPROBE_CPUPERF_0];
+  if (IsKeyKnown(misaligned)) {
+    const uint64_t speed = misaligned.value & RISCV_HWPROBE_MISALIGNED_MASK;
+    if (speed <= RISCV_MISALIGNED_UNSUPPORTED) {
+      info->misaligned_access_speed = (RiscvMisalignedAccessSpeed)speed;
+    }
+  }
+  if (IsKeyKnown(pairs[HWPROBE_ZICBOZ_BLOCK_SIZE]) &&
+      (ima_ext_0 & RISCV_HWPROBE_EXT_ZICBOZ)) {
+    info->zicboz_block_size = (int)pairs[HWPROBE_ZICBOZ_BLOCK_SIZE].value;
+  }
+  // Vendor extensions are reported since Linux 6.11, the other XThead*
+  // extensions only show up in the isa string.
+  const RiscvHwprobePair thead = pairs[HWPROBE_VENDOR_EXT_THEAD_0];
+  if (IsKeyKnown(thead) &&
+      (thead.value & RISCV_HWPROBE_VENDOR_EXT_XTHEADVECTOR)) {
+    features->XTheadVector = true;
+  }
+  return true;
+}
+
+static bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+static StringView PopDigits(StringView view) {
+  while (view.size && IsDigit(CpuFeatures_StringView_Front(view))) {
+    view = CpuFeatures_StringView_PopFront(view, 1);
+  }
+  return view;
+}
+
+// Removes the trailing version of a multi-letter extension, e.g. "zicsr2p0"
+// becomes "zicsr". Digits inside the name, as in "zve32x", are kept.
+static StringView RemoveVersion(StringView name) {
+  size_t size = name.size;
+  while (size && IsDigit(name.ptr[size - 1])) --size;
+  if (size == name.size) return name;
+  if (size > 1 && name.ptr[size - 1] == 'p' && IsDigit(name.ptr[size - 2])) {
+    --size;
+    while (size && IsDigit(name.ptr[size - 1])) --size;
+  }
+  return CpuFeatures_StringView_KeepFront(name, size);
+}
+
+static void SetExtension(const StringView name, RiscvFeatures* const features) {
+  // Skips the base ISA entries.
+  for (size_t i = RISCV_M; i < RISCV_LAST_; ++i) {
+    if (CpuFeatures_StringView_IsEquals(name, str(kCpuInfoFlags[i]))) {
+      kSetters[i](features, true);
+      return;
+    }
+  }
+}
+
+// Handles a run of single letter extensions with optional versions such as
+// "imafdc" or "i2p0m2p0a2p0". Returns what remains once a multi-letter
+// extension (starting with 'z', 's' or 'x') is reached.
+static StringView HandleSingleLetterExtensions(StringView run,
+                                               RiscvFeatures* const features) {
+  while (run.size) {
+    const char letter = CpuFeatures_StringView_Front(run);
+    if (letter == 'z' || letter == 's' || letter == 'x') break;
+    run = CpuFeatures_StringView_PopFront(run, 1);
+    // Skips the optional version "<major>[p<minor>]".
+    const StringView after_major = PopDigits(run);
+    if (after_major.size != run.size && after_major.size > 1 &&
+        CpuFeatures_StringView_Front(after_major) == 'p' &&
+        IsDigit(after_major.ptr[1])) {
+      run = PopDigits(CpuFeatures_StringView_PopFront(after_major, 1));
+    } else {
+      run = after_major;
+    }
+    if (letter == 'g') {
+      // G is a shorthand for IMAFD_Zicsr_Zifencei.
+      features->M = features->A = features->F = features->D = true;
+      features->Zicsr = features->Zifencei = true;
+    } else {
+      SetExtension(view(&letter, 1), features);
+    }
+  }
+  return run;
+}
 
 static void HandleRiscVIsaLine(StringView line, RiscvFeatures* const features) {
-  for (size_t i = 0; i < RISCV_LAST_; ++i) {
-    StringView flag = str(kCpuInfoFlags[i]);
-    int index_of_flag = CpuFeatures_StringView_IndexOf(line, flag);
-    bool is_set = index_of_flag != -1;
-    kSetters[i](features, is_set);
-    if (is_set)
-      line = CpuFeatures_StringView_PopFront(line, index_of_flag + flag.size);
+  const bool is_rv32 = CpuFeatures_StringView_StartsWith(line, str("rv32"));
+  const bool is_rv64 = CpuFeatures_StringView_StartsWith(line, str("rv64"));
+  if (!is_rv32 && !is_rv64) return;
+  line = CpuFeatures_StringView_PopFront(line, 4);
+  if (line.size && (CpuFeatures_StringView_Front(line) == 'i' ||
+                    CpuFeatures_StringView_Front(line) == 'g')) {
+    if (is_rv32) features->RV32I = true;
+    if (is_rv64) features->RV64I = true;
+  }
+  while (line.size) {
+    const int index = CpuFeatures_StringView_IndexOfChar(line, '_');
+    StringView token =
+        index < 0 ? line : CpuFeatures_StringView_KeepFront(line, index);
+    line = index < 0 ? kEmptyStringView
+                     : CpuFeatures_StringView_PopFront(line, index + 1);
+    token = HandleSingleLetterExtensions(token, features);
+    if (token.size) SetExtension(RemoveVersion(token), features);
   }
 }
 
@@ -101,9 +356,87 @@ static void FillProcCpuInfoData(RiscvInfo* const info) {
   }
 }
 
+// Whether hwprobe has a bit for `feature`, its answer is then authoritative.
+static bool IsReportedByHwprobe(const RiscvFeaturesEnum feature) {
+  switch (feature) {
+    case RISCV_RV32I:
+    case RISCV_RV64I:
+    case RISCV_M:
+    case RISCV_A:
+    case RISCV_F:
+    case RISCV_D:
+    case RISCV_Zicsr:
+    case RISCV_Zifencei:
+      return true;
+    default:
+      break;
+  }
+  for (size_t i = 0; i < sizeof(kHwprobeImaExt0) / sizeof(kHwprobeImaExt0[0]);
+       ++i) {
+    if (kHwprobeImaExt0[i].feature == feature) return true;
+  }
+  return false;
+}
+
 RiscvInfo GetRiscvInfo(void) {
   RiscvInfo info = kEmptyRiscvInfo;
-  FillProcCpuInfoData(&info);
+  RiscvInfo cpuinfo = kEmptyRiscvInfo;
+  // /proc/cpuinfo holds the vendor and uarch, and the isa string.
+  FillProcCpuInfoData(&cpuinfo);
+  memcpy(info.vendor, cpuinfo.vendor, sizeof(info.vendor));
+  memcpy(info.uarch, cpuinfo.uarch, sizeof(info.uarch));
+  if (!FillHwprobeData(&info)) {
+    info.features = cpuinfo.features;
+    return info;
+  }
+  // Extensions come from riscv_hwprobe when it has a bit for them. The isa
+  // string still provides the others, e.g. Q, Zvl*b and most vendor
+  // extensions.
+  for (size_t i = 0; i < RISCV_LAST_; ++i) {
+    if (!IsReportedByHwprobe((RiscvFeaturesEnum)i) &&
+        kGetters[i](&cpuinfo.features))
+      kSetters[i](&info.features, true);
+  }
+  return info;
+}
+
+// Returns the minimum VLEN in bits mandated by the reported extensions.
+static int GetMinimumVlen(const RiscvFeatures* const features) {
+  if (features->Zvl1024b) return 1024;
+  if (features->Zvl512b) return 512;
+  if (features->Zvl256b) return 256;
+  if (features->Zvl128b || features->V) return 128;
+  if (features->Zvl64b || features->Zve64x || features->Zve64f ||
+      features->Zve64d)
+    return 64;
+  if (features->Zvl32b || features->Zve32x || features->Zve32f) return 32;
+  return 0;
+}
+
+static int GetElen(const RiscvFeatures* const features) {
+  if (features->V || features->Zve64x || features->Zve64f || features->Zve64d)
+    return 64;
+  if (features->Zve32x || features->Zve32f) return 32;
+  return 0;
+}
+
+// Reading vlenb faults unless the kernel hands out the vector unit to this
+// thread: it advertises V in AT_HWCAP since Linux 6.5 and the unit can still
+// be withheld, e.g. with abi.riscv_v_default_allow=0.
+static bool IsVectorEnabledByOs(void) {
+  if (!(CpuFeatures_GetHardwareCapabilities().hwcaps & RISCV_HWCAP_V))
+    return false;
+  const long control = GetRiscvVectorControl();
+  return control >= 0 && (control & PR_RISCV_V_VSTATE_CTRL_CUR_MASK) ==
+                             PR_RISCV_V_VSTATE_CTRL_ON;
+}
+
+RiscvVectorInfo GetRiscvVectorInfo(void) {
+  RiscvVectorInfo info = kEmptyRiscvVectorInfo;
+  const RiscvFeatures features = GetRiscvInfo().features;
+  info.elen = GetElen(&features);
+  info.zvl = GetMinimumVlen(&features);
+  if (info.elen && IsVectorEnabledByOs()) info.vlen = (int)GetRiscvVlenb() * 8;
   return info;
 }
 
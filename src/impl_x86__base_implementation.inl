@@ -82,6 +82,8 @@
 // `ReadLeaves` function for `GetX86Info`, `GetCacheInfo` and
 // `FillX86BrandString` to read leaves and hold these values to avoid redundant
 // call on the same leaf.
+// When CPUID traps, e.g. in a virtual machine, every leaf read by any getter
+// is additionally kept in a process wide cache, see `CpuId`.
 
 #include <stdbool.h>
 #include <string.h>
@@ -91,6 +93,7 @@
 #include "equals.inl"
 #include "internal/bit_utils.h"
 #include "internal/cpuid_x86.h"
+#include "internal/hugepages.h"
 
 #if !defined(CPU_FEATURES_ARCH_X86)
 #error "Cannot compile cpuinfo_x86 on a non x86 platform."
@@ -143,11 +146,107 @@ uint32_t GetXCR0Eax(void) { return (uint32_t)_xgetbv(0); }
 #error "Unsupported compiler, x86 cpuid requires either GCC, Clang or MSVC."
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+// CPUID cache
+////////////////////////////////////////////////////////////////////////////////
+
+// CPUID is cheap on bare metal but in a virtual machine every call exits to
+// the hypervisor, in TDX or SEV-ES guests it goes through an exception handler
+// on top of that and with CPUID faulting it traps to the kernel. The cache
+// keeps the leaves read by all the getters, it is enabled when running under a
+// hypervisor or on request. CPUID faulting is only known through a syscall,
+// callers probe it with IsX86CpuidFaulting and opt in.
+#define CPUID_CACHE_UNKNOWN 0
+#define CPUID_CACHE_DISABLED 1
+#define CPUID_CACHE_ENABLED 2
+
+#define CPUID_CACHE_ENTRY_EMPTY 0
+#define CPUID_CACHE_ENTRY_WRITING 1
+#define CPUID_CACHE_ENTRY_READY 2
+
+// Large enough for the subleaves enumerated by the getters.
+#define CPUID_CACHE_SIZE 128
+
+#if defined(CPU_FEATURES_COMPILER_CLANG) || defined(CPU_FEATURES_COMPILER_GCC)
+typedef struct {
+  int state;
+  uint32_t leaf_id;
+  int ecx;
+  Leaf leaf;
+} CpuidCacheEntry;
+
+static CpuidCacheEntry g_cpuid_cache[CPUID_CACHE_SIZE];
+static int g_cpuid_cache_mode = CPUID_CACHE_UNKNOWN;
+
+static bool IsCpuidCacheEnabled(void) {
+  int mode = __atomic_load_n(&g_cpuid_cache_mode, __ATOMIC_RELAXED);
+  if (mode == CPUID_CACHE_UNKNOWN) {
+    const bool hypervisor = IsBitSet(GetCpuidLeaf(1, 0).ecx, 31);
+    const int detected =
+        hypervisor ? CPUID_CACHE_ENABLED : CPUID_CACHE_DISABLED;
+    // EnableX86CpuidCache may have been called in the meantime.
+    if (__atomic_compare_exchange_n(&g_cpuid_cache_mode, &mode, detected,
+                                    false, __ATOMIC_RELAXED,
+                                    __ATOMIC_RELAXED))
+      mode = detected;
+  }
+  return mode == CPUID_CACHE_ENABLED;
+}
+
+void EnableX86CpuidCache(void) {
+  __atomic_store_n(&g_cpuid_cache_mode, CPUID_CACHE_ENABLED, __ATOMIC_RELAXED);
+}
+
+// Looks the leaf up in an open addressing table. Entries are claimed by a
+// single thread and published once written, a thread missing a leaf being
+// written executes CPUID itself.
+static Leaf CpuId(uint32_t leaf_id, int ecx) {
+  if (!IsCpuidCacheEnabled()) return GetCpuidLeaf(leaf_id, ecx);
+  const uint32_t hash = (leaf_id ^ (leaf_id >> 16)) * 31 + (uint32_t)ecx;
+  for (size_t i = 0; i < CPUID_CACHE_SIZE; ++i) {
+    CpuidCacheEntry* const entry =
+        &g_cpuid_cache[(hash + i) % CPUID_CACHE_SIZE];
+    int state = __atomic_load_n(&entry->state, __ATOMIC_ACQUIRE);
+    if (state == CPUID_CACHE_ENTRY_EMPTY &&
+        __atomic_compare_exchange_n(&entry->state, &state,
+                                    CPUID_CACHE_ENTRY_WRITING, false,
+                                    __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+      entry->leaf_id = leaf_id;
+      entry->ecx = ecx;
+      entry->leaf = GetCpuidLeaf(leaf_id, ecx);
+      __atomic_store_n(&entry->state, CPUID_CACHE_ENTRY_READY,
+                       __ATOMIC_RELEASE);
+      return entry->leaf;
+    }
+    if (state == CPUID_CACHE_ENTRY_READY && entry->leaf_id == leaf_id &&
+        entry->ecx == ecx)
+      return entry->leaf;
+  }
+  return GetCpuidLeaf(leaf_id, ecx);
+}
+
+#if defined(CPU_FEATURES_MOCK_CPUID_X86)
+void ResetX86CpuidCacheForTesting(void) {
+  memset(g_cpuid_cache, 0, sizeof(g_cpuid_cache));
+  g_cpuid_cache_mode = CPUID_CACHE_UNKNOWN;
+}
+#endif  // CPU_FEATURES_MOCK_CPUID_X86
+#else
+// Without GNU atomics CPUID is always executed.
+void EnableX86CpuidCache(void) {}
+
+static bool IsCpuidCacheEnabled(void) { return false; }
+
+static Leaf CpuId(uint32_t leaf_id, int ecx) {
+  return GetCpuidLeaf(leaf_id, ecx);
+}
+#endif
+
 static const Leaf kEmptyLeaf;
 
 static Leaf SafeCpuIdEx(uint32_t max_cpuid_leaf, uint32_t leaf_id, int ecx) {
   if (leaf_id <= max_cpuid_leaf) {
-    return GetCpuidLeaf(leaf_id, ecx);
+    return CpuId(leaf_id, ecx);
   } else {
     return kEmptyLeaf;
   }
@@ -155,24 +254,28 @@ static Leaf SafeCpuIdEx(uint32_t max_cpuid_leaf, uint32_t leaf_id, int ecx) {
 
 typedef struct {
   uint32_t max_cpuid_leaf;
-  Leaf leaf_0;    // Root
-  Leaf leaf_1;    // Family, Model, Stepping
-  Leaf leaf_2;    // Intel cache info + features
-  Leaf leaf_7;    // Features
-  Leaf leaf_7_1;  // Features
+  Leaf leaf_0;     // Root
+  Leaf leaf_1;     // Family, Model, Stepping
+  Leaf leaf_2;     // Intel cache info + features
+  Leaf leaf_7;     // Features
+  Leaf leaf_7_1;   // Features
+  Leaf leaf_19;    // Key Locker
+  Leaf leaf_1e_1;  // AMX features
+  Leaf leaf_24;    // AVX10 Converged Vector ISA
   uint32_t max_cpuid_leaf_ext;
   Leaf leaf_80000000;  // Root for extended leaves
   Leaf leaf_80000001;  // AMD features features and cache
   Leaf leaf_80000002;  // brand string
   Leaf leaf_80000003;  // brand string
   Leaf leaf_80000004;  // brand string
+  Leaf leaf_80000008;  // Address sizes and extended features
   Leaf leaf_80000021;  // AMD Extended Feature Identification 2
 } Leaves;
 
 static Leaves ReadLeaves(void) {
-  const Leaf leaf_0 = GetCpuidLeaf(0, 0);
+  const Leaf leaf_0 = CpuId(0, 0);
   const uint32_t max_cpuid_leaf = leaf_0.eax;
-  const Leaf leaf_80000000 = GetCpuidLeaf(0x80000000, 0);
+  const Leaf leaf_80000000 = CpuId(0x80000000, 0);
   const uint32_t max_cpuid_leaf_ext = leaf_80000000.eax;
   return (Leaves){
       .max_cpuid_leaf = max_cpuid_leaf,
@@ -181,12 +284,16 @@ static Leaves ReadLeaves(void) {
       .leaf_2 = SafeCpuIdEx(max_cpuid_leaf, 0x00000002, 0),
       .leaf_7 = SafeCpuIdEx(max_cpuid_leaf, 0x00000007, 0),
       .leaf_7_1 = SafeCpuIdEx(max_cpuid_leaf, 0x00000007, 1),
+      .leaf_19 = SafeCpuIdEx(max_cpuid_leaf, 0x00000019, 0),
+      .leaf_1e_1 = SafeCpuIdEx(max_cpuid_leaf, 0x0000001E, 1),
+      .leaf_24 = SafeCpuIdEx(max_cpuid_leaf, 0x00000024, 0),
       .max_cpuid_leaf_ext = max_cpuid_leaf_ext,
       .leaf_80000000 = leaf_80000000,
       .leaf_80000001 = SafeCpuIdEx(max_cpuid_leaf_ext, 0x80000001, 0),
       .leaf_80000002 = SafeCpuIdEx(max_cpuid_leaf_ext, 0x80000002, 0),
       .leaf_80000003 = SafeCpuIdEx(max_cpuid_leaf_ext, 0x80000003, 0),
       .leaf_80000004 = SafeCpuIdEx(max_cpuid_leaf_ext, 0x80000004, 0),
+      .leaf_80000008 = SafeCpuIdEx(max_cpuid_leaf_ext, 0x80000008, 0),
       .leaf_80000021 = SafeCpuIdEx(max_cpuid_leaf_ext, 0x80000021, 0),
   };
 }
@@ -200,8 +307,10 @@ static Leaves ReadLeaves(void) {
 #define MASK_MASKREG 0x20
 #define MASK_ZMM0_15 0x40
 #define MASK_ZMM16_31 0x80
+#define MASK_PKRU 0x200
 #define MASK_XTILECFG 0x20000
 #define MASK_XTILEDATA 0x40000
+#define MASK_APX 0x80000
 
 static bool HasMask(uint32_t value, uint32_t mask) {
   return (value & mask) == mask;
@@ -226,6 +335,12 @@ static bool HasZmmOsXSave(uint32_t xcr0_eax) {
                                MASK_ZMM16_31);
 }
 
+// Checks that operating system saves and restores the protection key rights
+// register during context switches.
+static bool HasPkruOsXSave(uint32_t xcr0_eax) {
+  return HasMask(xcr0_eax, MASK_PKRU);
+}
+
 // Checks that operating system saves and restores AMX/TMUL state during context
 // switches.
 static bool HasTmmOsXSave(uint32_t xcr0_eax) {
@@ -233,6 +348,12 @@ static bool HasTmmOsXSave(uint32_t xcr0_eax) {
                                MASK_ZMM16_31 | MASK_XTILECFG | MASK_XTILEDATA);
 }
 
+// Checks that operating system saves and restores the extended general purpose
+// registers (r16-r31) during context switches.
+static bool HasApxOsXSave(uint32_t xcr0_eax) {
+  return HasMask(xcr0_eax, MASK_APX);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Vendor
 ////////////////////////////////////////////////////////////////////////////////
@@ -313,12 +434,25 @@ typedef struct {
   bool avx_registers;
   bool avx512_registers;
   bool amx_registers;
+  bool apx_registers;
+  bool pkru_register;
 } OsPreserves;
 
-// These two functions have to be implemented by the OS, that is the file
-// including this file.
+// These functions have to be implemented by the OS, that is the file including
+// this file.
 static void OverrideOsPreserves(OsPreserves* os_preserves);
 static void DetectFeaturesFromOs(X86Info* info, X86Features* features);
+static bool IsCpuidFaultingFromOs(void);
+static X86AmxPermission GetAmxPermissionFromOs(bool request);
+static X86UmwaitControl GetUmwaitControlFromOs(void);
+static void GetAddressSpaceFromOs(X86AddressSpace* info);
+static void GetProtectionKeysFromOs(ProtectionKeys* info);
+static bool IsRtmDisabledByOs(void);
+static X86ConfidentialGuest GetConfidentialGuestFromOs(void);
+static int EnableTaggedAddressesFromOs(int tag_bits);
+static void GetProfilingInfoFromOs(X86ProfilingInfo* info);
+static void GetRdtInfoFromOs(X86RdtInfo* info);
+static bool FillX86InfoFromOs(X86Info* info);
 
 // Reference https://en.wikipedia.org/wiki/CPUID.
 static void ParseCpuId(const Leaves* leaves, X86Info* info,
@@ -326,7 +460,11 @@ static void ParseCpuId(const Leaves* leaves, X86Info* info,
   const Leaf leaf_1 = leaves->leaf_1;
   const Leaf leaf_7 = leaves->leaf_7;
   const Leaf leaf_7_1 = leaves->leaf_7_1;
+  const Leaf leaf_19 = leaves->leaf_19;
+  const Leaf leaf_1e_1 = leaves->leaf_1e_1;
+  const Leaf leaf_24 = leaves->leaf_24;
   const Leaf leaf_80000001 = leaves->leaf_80000001;
+  const Leaf leaf_80000008 = leaves->leaf_80000008;
 
   const bool have_xsave = IsBitSet(leaf_1.ecx, 26);
   const bool have_osxsave = IsBitSet(leaf_1.ecx, 27);
@@ -359,10 +497,13 @@ static void ParseCpuId(const Leaves* leaves, X86Info* info,
   // Fill cpu features.
   features->fpu = IsBitSet(leaf_1.edx, 0);
   features->tsc = IsBitSet(leaf_1.edx, 4);
+  features->rdtscp = IsBitSet(leaf_80000001.edx, 27);
+  features->rdpid = IsBitSet(leaf_7.ecx, 22);
   features->cx8 = IsBitSet(leaf_1.edx, 8);
   features->clfsh = IsBitSet(leaf_1.edx, 19);
   features->mmx = IsBitSet(leaf_1.edx, 23);
   features->ss = IsBitSet(leaf_1.edx, 27);
+  features->hypervisor = IsBitSet(leaf_1.ecx, 31);
   features->pclmulqdq = IsBitSet(leaf_1.ecx, 1);
   features->smx = IsBitSet(leaf_1.ecx, 6);
   features->cx16 = IsBitSet(leaf_1.ecx, 13);
@@ -378,15 +519,32 @@ static void ParseCpuId(const Leaves* leaves, X86Info* info,
   features->bmi2 = IsBitSet(leaf_7.ebx, 8);
   features->erms = IsBitSet(leaf_7.ebx, 9);
   features->rtm = IsBitSet(leaf_7.ebx, 11);
+  features->rtm_always_abort = IsBitSet(leaf_7.edx, 11);
+  features->tsx_force_abort = IsBitSet(leaf_7.edx, 13);
+  // The OS may disable TSX as well, IsX86RtmUsable asks it.
+  features->rtm_usable = features->rtm && !features->rtm_always_abort;
   features->rdseed = IsBitSet(leaf_7.ebx, 18);
   features->clflushopt = IsBitSet(leaf_7.ebx, 23);
   features->clwb = IsBitSet(leaf_7.ebx, 24);
+  features->cldemote = IsBitSet(leaf_7.ecx, 25);
+  features->prefetchw = IsBitSet(leaf_80000001.ecx, 8);
+  features->prefetchi = IsBitSet(leaf_7_1.edx, 14);
+  features->wbnoinvd = IsBitSet(leaf_80000008.ebx, 9);
   features->sha = IsBitSet(leaf_7.ebx, 29);
+  features->kl = IsBitSet(leaf_7.ecx, 23);
+  if (features->kl) {
+    features->aeskle = IsBitSet(leaf_19.ebx, 0);
+    features->wide_kl = IsBitSet(leaf_19.ebx, 2);
+  }
   features->gfni = IsBitSet(leaf_7.ecx, 8);
   features->vaes = IsBitSet(leaf_7.ecx, 9);
   features->vpclmulqdq = IsBitSet(leaf_7.ecx, 10);
   features->movdiri = IsBitSet(leaf_7.ecx, 27);
   features->movdir64b = IsBitSet(leaf_7.ecx, 28);
+  features->waitpkg = IsBitSet(leaf_7.ecx, 5);
+  features->serialize = IsBitSet(leaf_7.edx, 14);
+  features->uintr = IsBitSet(leaf_7.edx, 5);
+  features->hreset = IsBitSet(leaf_7_1.eax, 22);
   features->fs_rep_mov = IsBitSet(leaf_7.edx, 4);
   features->fz_rep_movsb = IsBitSet(leaf_7_1.eax, 10);
   features->fs_rep_stosb = IsBitSet(leaf_7_1.eax, 11);
@@ -394,6 +552,9 @@ static void ParseCpuId(const Leaves* leaves, X86Info* info,
   features->adx = IsBitSet(leaf_7.ebx, 19);
   features->lzcnt = IsBitSet(leaf_80000001.ecx, 5);
   features->lam = IsBitSet(leaf_7_1.eax, 26);
+  // OSPKE mirrors CR4.PKE, RDPKRU and WRPKRU fault while it is clear.
+  features->ospke = IsBitSet(leaf_7.ecx, 4);
+  features->fsgsbase = IsBitSet(leaf_7.ebx, 0);
 
   /////////////////////////////////////////////////////////////////////////////
   // The following section is devoted to Vector Extensions.
@@ -409,6 +570,8 @@ static void ParseCpuId(const Leaves* leaves, X86Info* info,
     os_preserves->avx_registers = HasYmmOsXSave(xcr0_eax);
     os_preserves->avx512_registers = HasZmmOsXSave(xcr0_eax);
     os_preserves->amx_registers = HasTmmOsXSave(xcr0_eax);
+    os_preserves->apx_registers = HasApxOsXSave(xcr0_eax);
+    os_preserves->pkru_register = HasPkruOsXSave(xcr0_eax);
     OverrideOsPreserves(os_preserves);
 
     if (os_preserves->sse_registers) {
@@ -423,6 +586,13 @@ static void ParseCpuId(const Leaves* leaves, X86Info* info,
       features->fma3 = IsBitSet(leaf_1.ecx, 12);
       features->avx = IsBitSet(leaf_1.ecx, 28);
       features->avx_vnni = IsBitSet(leaf_7_1.eax, 4);
+      features->avx_vnni_int8 = IsBitSet(leaf_7_1.edx, 4);
+      features->avx_vnni_int16 = IsBitSet(leaf_7_1.edx, 10);
+      features->avx_ifma = IsBitSet(leaf_7_1.eax, 23);
+      features->avx_ne_convert = IsBitSet(leaf_7_1.edx, 5);
+      features->sha512 = IsBitSet(leaf_7_1.eax, 0);
+      features->sm3 = IsBitSet(leaf_7_1.eax, 1);
+      features->sm4 = IsBitSet(leaf_7_1.eax, 2);
       features->avx2 = IsBitSet(leaf_7.ebx, 5);
     }
     if (os_preserves->avx512_registers) {
@@ -446,12 +616,32 @@ static void ParseCpuId(const Leaves* leaves, X86Info* info,
       features->avx512_bf16 = IsBitSet(leaf_7_1.eax, 5);
       features->avx512_vp2intersect = IsBitSet(leaf_7.edx, 8);
       features->avx512_fp16 = IsBitSet(leaf_7.edx, 23);
+      // AVX10 requires the opmask and zmm states to be enabled in XCR0 even
+      // when it is limited to 256-bit vectors. Leaf 0x24 is only valid when
+      // CPUID.(EAX=07H,ECX=01H):EDX[bit 19] is set.
+      features->avx10 = IsBitSet(leaf_7_1.edx, 19);
+      if (features->avx10) {
+        info->avx10_version = ExtractBitRange(leaf_24.ebx, 7, 0);
+        features->avx10_256 = IsBitSet(leaf_24.ebx, 17);
+        features->avx10_512 = IsBitSet(leaf_24.ebx, 18);
+        info->avx10_max_vl = features->avx10_512   ? 512
+                             : features->avx10_256 ? 256
+                                                   : 128;
+      }
     }
     if (os_preserves->amx_registers) {
       features->amx_bf16 = IsBitSet(leaf_7.edx, 22);
       features->amx_tile = IsBitSet(leaf_7.edx, 24);
       features->amx_int8 = IsBitSet(leaf_7.edx, 25);
       features->amx_fp16 = IsBitSet(leaf_7_1.eax, 21);
+      features->amx_complex = IsBitSet(leaf_7_1.edx, 8);
+      features->amx_fp8 = IsBitSet(leaf_1e_1.eax, 4);
+    }
+    if (os_preserves->apx_registers) {
+      features->apx_f = IsBitSet(leaf_7_1.edx, 21);
+    }
+    if (os_preserves->pkru_register && features->ospke) {
+      features->pku = IsBitSet(leaf_7.ecx, 3);
     }
   } else {
     // When XCR0 is not available (Atom based or older cpus) we need to defer to
@@ -467,6 +657,7 @@ static void ParseCpuId(const Leaves* leaves, X86Info* info,
 static void ParseExtraAMDCpuId(const Leaves* leaves, X86Info* info,
                                OsPreserves os_preserves) {
   const Leaf leaf_80000001 = leaves->leaf_80000001;
+  const Leaf leaf_80000008 = leaves->leaf_80000008;
   const Leaf leaf_80000021 = leaves->leaf_80000021;
 
   X86Features* const features = &info->features;
@@ -479,6 +670,8 @@ static void ParseExtraAMDCpuId(const Leaves* leaves, X86Info* info,
     features->fma4 = IsBitSet(leaf_80000001.ecx, 16);
   }
 
+  features->monitorx = IsBitSet(leaf_80000001.ecx, 29);
+  features->clzero = IsBitSet(leaf_80000008.ebx, 0);
   features->uai = IsBitSet(leaf_80000021.eax, 7);
 }
 
@@ -508,6 +701,25 @@ X86Info GetX86Info(void) {
   return info;
 }
 
+int IsX86CpuidFaulting(void) { return IsCpuidFaultingFromOs(); }
+
+int IsX86RtmUsable(void) {
+  // TAA mitigations and tsx=off may leave the rtm bit set while transactions
+  // always abort, the OS is only asked when the cpu claims RTM works.
+  return GetX86Info().features.rtm_usable && !IsRtmDisabledByOs();
+}
+
+X86Info GetX86InfoFromOs(void) {
+  X86Info info = kEmptyX86Info;
+  if (!FillX86InfoFromOs(&info)) return GetX86Info();
+  // The OS does not report the features derived by cpu_features, it already
+  // hides rtm when TSX is disabled.
+  X86Features* const features = &info.features;
+  features->rtm_usable = features->rtm && !features->rtm_always_abort;
+  if (features->avx512f) features->avx512_second_fma = HasSecondFMA(&info);
+  return info;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Microarchitecture
 ////////////////////////////////////////////////////////////////////////////////
@@ -1873,6 +2085,8 @@ static void ParseLeaf2(const Leaves* leaves, CacheInfo* info) {
   for (size_t i = 0; i < sizeof(data); ++i) {
     const uint8_t descriptor = data[i];
     if (descriptor == 0) continue;
+    // Up to 15 descriptors may be reported.
+    if (info->size >= CPU_FEATURES_MAX_CACHE_LEVEL) break;
     info->levels[info->size] = GetCacheLevelInfo(descriptor);
     info->size++;
   }
@@ -1928,18 +2142,9 @@ typedef struct {
   CacheType cache_type;
 } CacheLevelInfoLegacyAMD;
 
-static int GetWaysLegacyAMD(int cache_level, const uint32_t cache_id) {
-  // https://www.amd.com/system/files/TechDocs/25481.pdf page 23
-  // CPUID.8000_0005_ECX[23:16] L1 data cache associativity.
-  // CPUID.8000_0005_EDX[23:16] L1 instruction cache associativity.
-  if (cache_level == 1) {
-    return ExtractBitRange(cache_id, 23, 16);
-  }
-  // https://www.amd.com/system/files/TechDocs/25481.pdf page 24
-  // See Table 4: L2/L3 Cache and TLB Associativity Field Definition.
-  // CPUID.8000_0006_ECX[15:12] L2 cache associativity.
-  // CPUID.8000_0006_EDX[15:12] L3 cache associativity.
-  const int ways = ExtractBitRange(cache_id, 15, 12);
+// https://www.amd.com/system/files/TechDocs/25481.pdf page 24
+// See Table 4: L2/L3 Cache and TLB Associativity Field Definition.
+static int DecodeWaysLegacyAMD(const int ways) {
   switch (ways) {
     case 0x0:
     case 0x1:
@@ -1967,6 +2172,19 @@ static int GetWaysLegacyAMD(int cache_level, const uint32_t cache_id) {
   }
 }
 
+static int GetWaysLegacyAMD(int cache_level, const uint32_t cache_id) {
+  // https://www.amd.com/system/files/TechDocs/25481.pdf page 23
+  // CPUID.8000_0005_ECX[23:16] L1 data cache associativity.
+  // CPUID.8000_0005_EDX[23:16] L1 instruction cache associativity.
+  if (cache_level == 1) {
+    return ExtractBitRange(cache_id, 23, 16);
+  }
+  // https://www.amd.com/system/files/TechDocs/25481.pdf page 24
+  // CPUID.8000_0006_ECX[15:12] L2 cache associativity.
+  // CPUID.8000_0006_EDX[15:12] L3 cache associativity.
+  return DecodeWaysLegacyAMD(ExtractBitRange(cache_id, 15, 12));
+}
+
 static int GetCacheSizeLegacyAMD(int cache_level, const uint32_t cache_id) {
   switch (cache_level) {
     case 1:
@@ -2053,87 +2271,753 @@ CacheInfo GetX86CacheInfo(void) {
   return info;
 }
 
+static const TlbInfo kEmptyTlbInfo;
+
+static void AddTlbLevel(TlbInfo* info, const TlbLevelInfo tlb) {
+  if (tlb.entries == 0 || info->size >= CPU_FEATURES_MAX_TLB_LEVEL) return;
+  info->levels[info->size] = tlb;
+  ++info->size;
+}
+
+// https://www.felixcloutier.com/x86/cpuid#input-eax-=-18h--returns-deterministic-address-translation-parameters
+static void ParseTlbInfo(const uint32_t max_cpuid_leaf, TlbInfo* info) {
+  const Leaf leaf_18 = SafeCpuIdEx(max_cpuid_leaf, 0x00000018, 0);
+  for (uint32_t index = 0; index <= leaf_18.eax; ++index) {
+    const Leaf leaf = SafeCpuIdEx(max_cpuid_leaf, 0x00000018, index);
+    // Subleaves with a null type are invalid and must be skipped.
+    const int tlb_type = ExtractBitRange(leaf.edx, 4, 0);
+    if (tlb_type == CPU_FEATURE_TLB_NULL || tlb_type > CPU_FEATURE_TLB_STORE)
+      continue;
+    const int ways = ExtractBitRange(leaf.ebx, 31, 16);
+    AddTlbLevel(info,
+                (TlbLevelInfo){.level = ExtractBitRange(leaf.edx, 7, 5),
+                               .tlb_type = (TlbType)tlb_type,
+                               .page_4k = IsBitSet(leaf.ebx, 0),
+                               .page_2m = IsBitSet(leaf.ebx, 1),
+                               .page_4m = IsBitSet(leaf.ebx, 2),
+                               .page_1g = IsBitSet(leaf.ebx, 3),
+                               .entries = ways * leaf.ecx,
+                               .ways = IsBitSet(leaf.edx, 8) ? 0xFF : ways});
+  }
+}
+
+// Each register describes the data TLB in its upper half and the instruction
+// TLB in its lower half. L1 4 KiB and 2 MiB TLBs hold 8-bit counts and
+// associativities, the others 12-bit counts and encoded associativities.
+static void AddTlbLevelsLegacyAMD(TlbInfo* info, TlbLevelInfo tlb,
+                                  const uint32_t reg, const bool encoded) {
+  const uint32_t halves[2] = {reg >> 16, reg & 0xFFFF};
+  const TlbType types[2] = {CPU_FEATURE_TLB_DATA, CPU_FEATURE_TLB_INSTRUCTION};
+  for (int i = 0; i < 2; ++i) {
+    tlb.tlb_type = types[i];
+    if (encoded) {
+      tlb.entries = ExtractBitRange(halves[i], 11, 0);
+      tlb.ways = DecodeWaysLegacyAMD(ExtractBitRange(halves[i], 15, 12));
+    } else {
+      tlb.entries = ExtractBitRange(halves[i], 7, 0);
+      tlb.ways = ExtractBitRange(halves[i], 15, 8);
+    }
+    AddTlbLevel(info, tlb);
+  }
+}
+
+// https://www.amd.com/system/files/TechDocs/24594.pdf
+// CPUID Fn8000_0005, Fn8000_0006 and Fn8000_0019.
+static void ParseTlbInfoLegacyAMD(const uint32_t max_ext, TlbInfo* info) {
+  const Leaf leaf_80000005 = SafeCpuIdEx(max_ext, 0x80000005, 0);
+  const Leaf leaf_80000006 = SafeCpuIdEx(max_ext, 0x80000006, 0);
+  const Leaf leaf_80000019 = SafeCpuIdEx(max_ext, 0x80000019, 0);
+  const TlbLevelInfo l1_4k = {.level = 1, .page_4k = true};
+  const TlbLevelInfo l1_2m = {.level = 1, .page_2m = true, .page_4m = true};
+  const TlbLevelInfo l1_1g = {.level = 1, .page_1g = true};
+  const TlbLevelInfo l2_4k = {.level = 2, .page_4k = true};
+  const TlbLevelInfo l2_2m = {.level = 2, .page_2m = true, .page_4m = true};
+  const TlbLevelInfo l2_1g = {.level = 2, .page_1g = true};
+  AddTlbLevelsLegacyAMD(info, l1_4k, leaf_80000005.ebx, false);
+  AddTlbLevelsLegacyAMD(info, l1_2m, leaf_80000005.eax, false);
+  AddTlbLevelsLegacyAMD(info, l1_1g, leaf_80000019.eax, true);
+  AddTlbLevelsLegacyAMD(info, l2_4k, leaf_80000006.ebx, true);
+  AddTlbLevelsLegacyAMD(info, l2_2m, leaf_80000006.eax, true);
+  AddTlbLevelsLegacyAMD(info, l2_1g, leaf_80000019.ebx, true);
+}
+
+TlbInfo GetX86TlbInfo(void) {
+  TlbInfo info = kEmptyTlbInfo;
+  const Leaves leaves = ReadLeaves();
+  if (IsVendor(leaves.leaf_0, CPU_FEATURES_VENDOR_GENUINE_INTEL) ||
+      IsVendor(leaves.leaf_0, CPU_FEATURES_VENDOR_CENTAUR_HAULS) ||
+      IsVendor(leaves.leaf_0, CPU_FEATURES_VENDOR_SHANGHAI)) {
+    ParseTlbInfo(leaves.max_cpuid_leaf, &info);
+  } else if (IsVendor(leaves.leaf_0, CPU_FEATURES_VENDOR_AUTHENTIC_AMD) ||
+             IsVendor(leaves.leaf_0, CPU_FEATURES_VENDOR_HYGON_GENUINE)) {
+    ParseTlbInfoLegacyAMD(leaves.max_cpuid_leaf_ext, &info);
+  }
+  return info;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Huge pages
+////////////////////////////////////////////////////////////////////////////////
+
+// The size of a page directory entry mapping depends on the paging mode of the
+// kernel: 2M in long mode and with PAE, 4M with legacy 32-bit paging.
+static int GetPseHugePageSizeKb(const Leaves* leaves) {
+#if defined(CPU_FEATURES_ARCH_X86_32)
+  // A 32-bit process may run on any of them, the kernel default size tells
+  // legacy paging apart. Without it, assume the kernel uses PAE when the cpu
+  // has it.
+  const int default_kb = CpuFeatures_GetDefaultHugePageSizeFromOs();
+  if (default_kb == 4096) return 4096;
+  if (default_kb == 0 && !IsBitSet(leaves->leaf_1.edx, 6)) return 4096;
+#else
+  (void)leaves;
+#endif
+  return 2048;
+}
+
+HugePageInfo GetX86HugePageInfo(void) {
+  HugePageInfo info = {.page_size = 4096};
+  const Leaves leaves = ReadLeaves();
+  const int pse_kb = GetPseHugePageSizeKb(&leaves);
+  if (IsBitSet(leaves.leaf_1.edx, 3))
+    CpuFeatures_AddHugePageSize(&info, pse_kb);
+  // PDPE1GB allows 1G pages, they do not exist with legacy 32-bit paging.
+  if (IsBitSet(leaves.leaf_80000001.edx, 26) && pse_kb == 2048)
+    CpuFeatures_AddHugePageSize(&info, 1024 * 1024);
+  CpuFeatures_FillHugePageInfoFromOs(&info);
+  return info;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// XSAVE
+////////////////////////////////////////////////////////////////////////////////
+
+static const X86XSaveInfo kEmptyX86XSaveInfo;
+
+// The x87 and SSE states live in the 512-byte legacy region at a fixed
+// location, they are followed by the 64-byte XSAVE header.
+#define XSAVE_LEGACY_REGION_SIZE 512
+#define XSAVE_HEADER_SIZE 64
+
+// https://www.felixcloutier.com/x86/cpuid#input-eax-=-0dh--returns-processor-extended-states-enumeration
+static void ParseXSaveComponents(const uint32_t max_cpuid_leaf,
+                                 X86XSaveInfo* info) {
+  const uint64_t components =
+      info->user_components | info->supervisor_components;
+  for (int index = 0; index < CPU_FEATURES_MAX_XSAVE_COMPONENTS; ++index) {
+    if (!(components & ((uint64_t)1 << index))) continue;
+    X86XSaveComponent* const component = &info->components[index];
+    if (index == 0) {
+      *component = (X86XSaveComponent){.size = 160, .offset = 0};
+    } else if (index == 1) {
+      *component = (X86XSaveComponent){.size = 256, .offset = 160};
+    } else {
+      const Leaf leaf = SafeCpuIdEx(max_cpuid_leaf, 0x0000000D, index);
+      *component = (X86XSaveComponent){.size = leaf.eax,
+                                       .offset = leaf.ebx,
+                                       .supervisor = IsBitSet(leaf.ecx, 0),
+                                       .aligned = IsBitSet(leaf.ecx, 1),
+                                       .xfd = IsBitSet(leaf.ecx, 2)};
+    }
+  }
+}
+
+X86XSaveInfo GetX86XSaveInfo(void) {
+  X86XSaveInfo info = kEmptyX86XSaveInfo;
+  const Leaves leaves = ReadLeaves();
+  if (!IsBitSet(leaves.leaf_1.ecx, 26)) return info;
+  const Leaf leaf_d = SafeCpuIdEx(leaves.max_cpuid_leaf, 0x0000000D, 0);
+  const Leaf leaf_d_1 = SafeCpuIdEx(leaves.max_cpuid_leaf, 0x0000000D, 1);
+  info.xsaveopt = IsBitSet(leaf_d_1.eax, 0);
+  info.xsavec = IsBitSet(leaf_d_1.eax, 1);
+  info.xgetbv_ecx1 = IsBitSet(leaf_d_1.eax, 2);
+  info.xsaves = IsBitSet(leaf_d_1.eax, 3);
+  info.xfd = IsBitSet(leaf_d_1.eax, 4);
+  info.user_components = ((uint64_t)leaf_d.edx << 32) | leaf_d.eax;
+  info.supervisor_components = ((uint64_t)leaf_d_1.edx << 32) | leaf_d_1.ecx;
+  // XCR0 can only be read once the OS has enabled XSAVE.
+  if (IsBitSet(leaves.leaf_1.ecx, 27)) info.enabled_components = GetXCR0Eax();
+  info.enabled_size = leaf_d.ebx;
+  info.max_size = leaf_d.ecx;
+  info.enabled_compacted_size = leaf_d_1.ebx;
+  ParseXSaveComponents(leaves.max_cpuid_leaf, &info);
+  return info;
+}
+
+int GetX86XSaveCompactedSize(const X86XSaveInfo* info, uint64_t mask) {
+  int size = XSAVE_LEGACY_REGION_SIZE + XSAVE_HEADER_SIZE;
+  // In the compacted format the components following the header are packed
+  // in index order, the legacy ones always occupy the legacy region.
+  for (int index = 0; index < 64; ++index) {
+    if (!(mask & ((uint64_t)1 << index))) continue;
+    if (index >= CPU_FEATURES_MAX_XSAVE_COMPONENTS) return 0;
+    const X86XSaveComponent component = info->components[index];
+    if (component.size == 0) return 0;
+    if (index < 2) continue;
+    if (component.aligned) size = (size + 63) & ~63;
+    size += component.size;
+  }
+  return size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Crypto
+////////////////////////////////////////////////////////////////////////////////
+
+CryptoFeatures GetX86CryptoFeatures(const X86Features* features) {
+  return (CryptoFeatures){
+      .aes = features->aes,
+      .clmul = features->pclmulqdq,
+      .sha1 = features->sha,
+      .sha256 = features->sha,
+      .sha512 = features->sha512,
+      .sm3 = features->sm3,
+      .sm4 = features->sm4,
+      .aes_wrapped_key = features->aeskle,
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Protection keys
+////////////////////////////////////////////////////////////////////////////////
+
+ProtectionKeys GetX86ProtectionKeys(void) {
+  ProtectionKeys info = {.supported = GetX86Info().features.pku,
+                         .num_keys = -1};
+  if (info.supported) GetProtectionKeysFromOs(&info);
+  return info;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// AMX
+////////////////////////////////////////////////////////////////////////////////
+
+static const X86AmxInfo kEmptyX86AmxInfo;
+
+// https://www.felixcloutier.com/x86/cpuid#input-eax-=-1dh--returns-tile-information
+// https://www.felixcloutier.com/x86/cpuid#input-eax-=-1eh--returns-tmul-information
+X86AmxInfo GetX86AmxInfo(void) {
+  X86AmxInfo info = kEmptyX86AmxInfo;
+  const Leaves leaves = ReadLeaves();
+  if (!IsBitSet(leaves.leaf_7.edx, 24)) return info;
+  const Leaf leaf_1d = SafeCpuIdEx(leaves.max_cpuid_leaf, 0x0000001D, 0);
+  info.max_palette = leaf_1d.eax;
+  for (int id = 1;
+       id <= info.max_palette && id < CPU_FEATURES_MAX_AMX_PALETTES; ++id) {
+    const Leaf leaf = SafeCpuIdEx(leaves.max_cpuid_leaf, 0x0000001D, id);
+    info.palettes[id] = (X86AmxPalette){
+        .total_tile_bytes = ExtractBitRange(leaf.eax, 15, 0),
+        .bytes_per_tile = ExtractBitRange(leaf.eax, 31, 16),
+        .bytes_per_row = ExtractBitRange(leaf.ebx, 15, 0),
+        .max_names = ExtractBitRange(leaf.ebx, 31, 16),
+        .max_rows = ExtractBitRange(leaf.ecx, 15, 0)};
+  }
+  const Leaf leaf_1e = SafeCpuIdEx(leaves.max_cpuid_leaf, 0x0000001E, 0);
+  info.tmul_max_k = ExtractBitRange(leaf_1e.ebx, 7, 0);
+  info.tmul_max_n = ExtractBitRange(leaf_1e.ebx, 23, 8);
+  return info;
+}
+
+static X86AmxPermission GetAmxPermission(bool request) {
+  const Leaves leaves = ReadLeaves();
+  const bool have_xcr0 =
+      IsBitSet(leaves.leaf_1.ecx, 26) && IsBitSet(leaves.leaf_1.ecx, 27);
+  if (!IsBitSet(leaves.leaf_7.edx, 24) || !have_xcr0 ||
+      !HasMask(GetXCR0Eax(), MASK_XTILECFG | MASK_XTILEDATA)) {
+    return X86_AMX_PERMISSION_UNSUPPORTED;
+  }
+  return GetAmxPermissionFromOs(request);
+}
+
+X86AmxPermission GetX86AmxPermission(void) { return GetAmxPermission(false); }
+
+X86AmxPermission RequestX86AmxPermission(void) {
+  return GetAmxPermission(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// UMWAIT
+////////////////////////////////////////////////////////////////////////////////
+
+static const X86UmwaitControl kUnknownUmwaitControl = {.max_time = -1,
+                                                       .c02_enabled = -1};
+
+X86UmwaitControl GetX86UmwaitControl(void) {
+  const Leaves leaves = ReadLeaves();
+  if (!IsBitSet(leaves.leaf_7.ecx, 5)) return kUnknownUmwaitControl;
+  return GetUmwaitControlFromOs();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Address space
+////////////////////////////////////////////////////////////////////////////////
+
+X86AddressSpace GetX86AddressSpace(void) {
+  const Leaves leaves = ReadLeaves();
+  X86AddressSpace info = {
+      .physical_address_bits = ExtractBitRange(leaves.leaf_80000008.eax, 7, 0),
+      .virtual_address_bits = ExtractBitRange(leaves.leaf_80000008.eax, 15, 8),
+      .la57 = IsBitSet(leaves.leaf_7.ecx, 16),
+      .la57_enabled = -1,
+      .max_tag_bits = -1,
+      .tag_bits = -1,
+  };
+  GetAddressSpaceFromOs(&info);
+  if (!info.la57) info.la57_enabled = 0;
+  if (!IsBitSet(leaves.leaf_7_1.eax, 26)) {
+    info.max_tag_bits = 0;
+    info.tag_bits = 0;
+  }
+  return info;
+}
+
+int EnableX86TaggedAddresses(int tag_bits) {
+  const Leaves leaves = ReadLeaves();
+  if (!IsBitSet(leaves.leaf_7_1.eax, 26)) return -1;
+  return EnableTaggedAddressesFromOs(tag_bits);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Profiling
+////////////////////////////////////////////////////////////////////////////////
+
+static const X86ProfilingInfo kEmptyX86ProfilingInfo = {
+    .perf_cpu = -1,
+    .perf_intel_pt = -1,
+    .perf_ibs_fetch = -1,
+    .perf_ibs_op = -1,
+};
+
+// https://www.felixcloutier.com/x86/cpuid#input-eax-=-0ah--returns-architectural-performance-monitoring-features
+// https://www.felixcloutier.com/x86/cpuid#input-eax-=-14h--returns-intel-processor-trace-enumeration-information
+// https://www.felixcloutier.com/x86/cpuid#input-eax-=-1ch--returns-architectural-lbr-information
+static void ParseIntelProfilingInfo(const Leaves* leaves,
+                                    X86ProfilingInfo* info) {
+  const Leaf leaf_a = SafeCpuIdEx(leaves->max_cpuid_leaf, 0x0000000A, 0);
+  info->pmu_version = ExtractBitRange(leaf_a.eax, 7, 0);
+  if (info->pmu_version > 0) {
+    info->gp_counters = ExtractBitRange(leaf_a.eax, 15, 8);
+    info->gp_counter_width = ExtractBitRange(leaf_a.eax, 23, 16);
+  }
+  if (info->pmu_version > 1) {
+    info->fixed_counters = ExtractBitRange(leaf_a.edx, 4, 0);
+    info->fixed_counter_width = ExtractBitRange(leaf_a.edx, 12, 5);
+  }
+  info->arch_lbr = IsBitSet(leaves->leaf_7.edx, 19);
+  if (info->arch_lbr) {
+    // Bit n is set when a depth of 8 * (n + 1) records is supported.
+    const Leaf leaf_1c = SafeCpuIdEx(leaves->max_cpuid_leaf, 0x0000001C, 0);
+    for (int n = 0; n < 8; ++n)
+      if (IsBitSet(leaf_1c.eax, n)) info->lbr_depth = 8 * (n + 1);
+  }
+  info->intel_pt = IsBitSet(leaves->leaf_7.ebx, 25);
+  if (info->intel_pt) {
+    const Leaf leaf_14 = SafeCpuIdEx(leaves->max_cpuid_leaf, 0x00000014, 0);
+    info->pt_cr3_filtering = IsBitSet(leaf_14.ebx, 0);
+    info->pt_cycle_accurate = IsBitSet(leaf_14.ebx, 1);
+    info->pt_ip_filtering = IsBitSet(leaf_14.ebx, 2);
+    info->pt_mtc = IsBitSet(leaf_14.ebx, 3);
+    info->pt_ptwrite = IsBitSet(leaf_14.ebx, 4);
+    info->pt_power_event_trace = IsBitSet(leaf_14.ebx, 5);
+    info->pt_topa = IsBitSet(leaf_14.ecx, 0);
+    info->pt_single_range_output = IsBitSet(leaf_14.ecx, 2);
+    if (leaf_14.eax >= 1) {
+      const Leaf leaf_14_1 =
+          SafeCpuIdEx(leaves->max_cpuid_leaf, 0x00000014, 1);
+      info->pt_address_ranges = ExtractBitRange(leaf_14_1.eax, 2, 0);
+    }
+  }
+}
+
+// https://www.amd.com/system/files/TechDocs/24594.pdf
+static void ParseAmdProfilingInfo(const Leaves* leaves,
+                                  X86ProfilingInfo* info) {
+  // Legacy core counters are 48 bits wide, PerfCtrExtCore adds two of them.
+  info->gp_counters = IsBitSet(leaves->leaf_80000001.ecx, 23) ? 6 : 4;
+  info->gp_counter_width = 48;
+  const Leaf leaf_80000022 =
+      SafeCpuIdEx(leaves->max_cpuid_leaf_ext, 0x80000022, 0);
+  info->perfmon_v2 = IsBitSet(leaf_80000022.eax, 0);
+  info->amd_lbr_v2 = IsBitSet(leaf_80000022.eax, 1);
+  if (info->perfmon_v2)
+    info->gp_counters = ExtractBitRange(leaf_80000022.ebx, 3, 0);
+  if (info->amd_lbr_v2)
+    info->lbr_depth = ExtractBitRange(leaf_80000022.ebx, 9, 4);
+  info->ibs = IsBitSet(leaves->leaf_80000001.ecx, 10);
+  if (info->ibs) {
+    const Leaf leaf_8000001b =
+        SafeCpuIdEx(leaves->max_cpuid_leaf_ext, 0x8000001B, 0);
+    // The remaining bits are only meaningful when IBSFFV is set.
+    if (IsBitSet(leaf_8000001b.eax, 0)) {
+      info->ibs_fetch_sampling = IsBitSet(leaf_8000001b.eax, 1);
+      info->ibs_op_sampling = IsBitSet(leaf_8000001b.eax, 2);
+      info->ibs_branch_target = IsBitSet(leaf_8000001b.eax, 5);
+      info->ibs_l3_miss_filtering = IsBitSet(leaf_8000001b.eax, 11);
+    }
+  }
+}
+
+X86ProfilingInfo GetX86ProfilingInfo(void) {
+  X86ProfilingInfo info = kEmptyX86ProfilingInfo;
+  const Leaves leaves = ReadLeaves();
+  info.pdcm = IsBitSet(leaves.leaf_1.ecx, 15);
+  info.ds = IsBitSet(leaves.leaf_1.edx, 21);
+  if (IsVendor(leaves.leaf_0, CPU_FEATURES_VENDOR_GENUINE_INTEL)) {
+    ParseIntelProfilingInfo(&leaves, &info);
+  } else if (IsVendor(leaves.leaf_0, CPU_FEATURES_VENDOR_AUTHENTIC_AMD) ||
+             IsVendor(leaves.leaf_0, CPU_FEATURES_VENDOR_HYGON_GENUINE)) {
+    ParseAmdProfilingInfo(&leaves, &info);
+  }
+  GetProfilingInfoFromOs(&info);
+  return info;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// RDT
+////////////////////////////////////////////////////////////////////////////////
+
+static const X86RdtInfo kEmptyX86RdtInfo = {
+    .resctrl_l3_classes = -1,
+    .resctrl_l2_classes = -1,
+    .resctrl_mba_classes = -1,
+    .resctrl_mon_rmids = -1,
+    .resctrl_mba_granularity = -1,
+    .resctrl_mba_min_bandwidth = -1,
+};
+
+// https://www.felixcloutier.com/x86/cpuid#input-eax-=-0fh--returns-intel-resource-director-technology--intel-rdt--monitoring-enumeration-information
+// https://www.felixcloutier.com/x86/cpuid#input-eax-=-10h--returns-intel-resource-director-technology--intel-rdt--allocation-enumeration-information
+// https://www.amd.com/system/files/TechDocs/56375_1.03_PUB.pdf
+X86RdtInfo GetX86RdtInfo(void) {
+  X86RdtInfo info = kEmptyX86RdtInfo;
+  const Leaves leaves = ReadLeaves();
+  const uint32_t max_cpuid_leaf = leaves.max_cpuid_leaf;
+  if (IsBitSet(leaves.leaf_7.ebx, 12)) {
+    const Leaf leaf_f = SafeCpuIdEx(max_cpuid_leaf, 0x0000000F, 0);
+    if (IsBitSet(leaf_f.edx, 1)) {
+      const Leaf leaf_f_1 = SafeCpuIdEx(max_cpuid_leaf, 0x0000000F, 1);
+      info.cmt = IsBitSet(leaf_f_1.edx, 0);
+      info.mbm_total = IsBitSet(leaf_f_1.edx, 1);
+      info.mbm_local = IsBitSet(leaf_f_1.edx, 2);
+      info.mon_rmids = leaf_f_1.ecx + 1;
+      info.mon_upscaling_factor = leaf_f_1.ebx;
+      // The width is encoded as an offset from 24 bits.
+      info.mbm_counter_width = 24 + ExtractBitRange(leaf_f_1.eax, 7, 0);
+    }
+  }
+  if (IsBitSet(leaves.leaf_7.ebx, 15)) {
+    const Leaf leaf_10 = SafeCpuIdEx(max_cpuid_leaf, 0x00000010, 0);
+    if (IsBitSet(leaf_10.ebx, 1)) {
+      const Leaf leaf_10_1 = SafeCpuIdEx(max_cpuid_leaf, 0x00000010, 1);
+      info.l3_cat = true;
+      info.l3_cdp = IsBitSet(leaf_10_1.ecx, 2);
+      info.l3_cat_classes = ExtractBitRange(leaf_10_1.edx, 15, 0) + 1;
+      info.l3_cbm_length = ExtractBitRange(leaf_10_1.eax, 4, 0) + 1;
+    }
+    if (IsBitSet(leaf_10.ebx, 2)) {
+      const Leaf leaf_10_2 = SafeCpuIdEx(max_cpuid_leaf, 0x00000010, 2);
+      info.l2_cat = true;
+      info.l2_cdp = IsBitSet(leaf_10_2.ecx, 2);
+      info.l2_cat_classes = ExtractBitRange(leaf_10_2.edx, 15, 0) + 1;
+      info.l2_cbm_length = ExtractBitRange(leaf_10_2.eax, 4, 0) + 1;
+    }
+    if (IsBitSet(leaf_10.ebx, 3)) {
+      const Leaf leaf_10_3 = SafeCpuIdEx(max_cpuid_leaf, 0x00000010, 3);
+      info.mba = true;
+      info.mba_linear = IsBitSet(leaf_10_3.ecx, 2);
+      info.mba_classes = ExtractBitRange(leaf_10_3.edx, 15, 0) + 1;
+      info.mba_max_value = ExtractBitRange(leaf_10_3.eax, 11, 0) + 1;
+      // Linear delays throttle in steps of the smallest bandwidth, as the
+      // kernel does for resctrl.
+      if (info.mba_linear && info.mba_max_value < 100)
+        info.mba_granularity = 100 - info.mba_max_value;
+    }
+    if (IsVendor(leaves.leaf_0, CPU_FEATURES_VENDOR_AUTHENTIC_AMD) ||
+        IsVendor(leaves.leaf_0, CPU_FEATURES_VENDOR_HYGON_GENUINE)) {
+      // AMD enumerates bandwidth enforcement separately, limits are absolute
+      // bandwidths instead of delays.
+      const Leaf leaf_80000020 =
+          SafeCpuIdEx(leaves.max_cpuid_leaf_ext, 0x80000020, 0);
+      if (IsBitSet(leaf_80000020.ebx, 1)) {
+        const Leaf leaf_80000020_1 =
+            SafeCpuIdEx(leaves.max_cpuid_leaf_ext, 0x80000020, 1);
+        info.mba = true;
+        info.mba_classes = leaf_80000020_1.edx + 1;
+        info.mba_max_value = 1 << leaf_80000020_1.eax;
+      }
+    }
+  }
+  GetRdtInfoFromOs(&info);
+  return info;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Hypervisor
+////////////////////////////////////////////////////////////////////////////////
+
+static const X86HypervisorInfo kEmptyX86HypervisorInfo;
+
+// Hypervisors expose their leaves in blocks of 0x100, a hypervisor emulating
+// Hyper-V (e.g. KVM or Xen with enlightenments) moves its own block up.
+#define HYPERVISOR_BASE_LEAF 0x40000000
+#define HYPERVISOR_LAST_BASE_LEAF 0x40000300
+#define HYPERVISOR_BASE_STEP 0x100
+
+#define HYPERVISOR_KVM "KVMKVMKVM\0\0\0"
+#define HYPERVISOR_HYPERV "Microsoft Hv"
+#define HYPERVISOR_XEN "XenVMMXenVMM"
+#define HYPERVISOR_VMWARE "VMwareVMware"
+#define HYPERVISOR_BHYVE "bhyve bhyve "
+#define HYPERVISOR_QEMU_TCG "TCGTCGTCGTCG"
+
+// Unlike the cpu vendor, the signature is stored in EBX, ECX, EDX order.
+static void SetHypervisorSignature(const Leaf leaf, char* const signature) {
+  memcpy(signature, &leaf.ebx, 4);
+  memcpy(signature + 4, &leaf.ecx, 4);
+  memcpy(signature + 8, &leaf.edx, 4);
+  signature[12] = '\0';
+}
+
+static bool IsHypervisor(const char* const signature, const char* const name) {
+  return memcmp(signature, name, 12) == 0;
+}
+
+static X86HypervisorVendor GetHypervisorVendor(const char* const signature) {
+  if (IsHypervisor(signature, HYPERVISOR_KVM)) return X86_HYPERVISOR_KVM;
+  if (IsHypervisor(signature, HYPERVISOR_HYPERV)) return X86_HYPERVISOR_HYPERV;
+  if (IsHypervisor(signature, HYPERVISOR_XEN)) return X86_HYPERVISOR_XEN;
+  if (IsHypervisor(signature, HYPERVISOR_VMWARE)) return X86_HYPERVISOR_VMWARE;
+  if (IsHypervisor(signature, HYPERVISOR_BHYVE)) return X86_HYPERVISOR_BHYVE;
+  if (IsHypervisor(signature, HYPERVISOR_QEMU_TCG))
+    return X86_HYPERVISOR_QEMU_TCG;
+  return X86_HYPERVISOR_UNKNOWN;
+}
+
+// https://docs.kernel.org/virt/kvm/x86/cpuid.html
+static void ParseKvmLeaves(uint32_t base, uint32_t max_leaf,
+                           X86HypervisorInfo* info) {
+  const Leaf features = SafeCpuIdEx(max_leaf, base + 1, 0);
+  // KVM_FEATURE_CLOCKSOURCE and KVM_FEATURE_CLOCKSOURCE2 use different MSRs.
+  info->kvm_clocksource =
+      IsBitSet(features.eax, 0) || IsBitSet(features.eax, 3);
+  info->kvm_async_pf = IsBitSet(features.eax, 4);
+  info->kvm_steal_time = IsBitSet(features.eax, 5);
+  info->kvm_pv_eoi = IsBitSet(features.eax, 6);
+  info->kvm_pv_unhalt = IsBitSet(features.eax, 7);
+  info->kvm_pv_tlb_flush = IsBitSet(features.eax, 9);
+  info->kvm_pv_send_ipi = IsBitSet(features.eax, 11);
+  info->kvm_poll_control = IsBitSet(features.eax, 12);
+  info->kvm_pv_sched_yield = IsBitSet(features.eax, 13);
+  info->kvm_hint_realtime = IsBitSet(features.edx, 0);
+}
+
+// https://learn.microsoft.com/en-us/virtualization/hyper-v-on-windows/tlfs/feature-discovery
+static void ParseHypervLeaves(uint32_t base, uint32_t max_leaf,
+                              X86HypervisorInfo* info) {
+  // "Hv#1" is the only interface exposing the leaves below.
+  if (SafeCpuIdEx(max_leaf, base + 1, 0).eax != 0x31237648) return;
+  const Leaf privileges = SafeCpuIdEx(max_leaf, base + 3, 0);
+  info->hyperv_reference_counter = IsBitSet(privileges.eax, 1);
+  info->hyperv_synic = IsBitSet(privileges.eax, 2);
+  info->hyperv_synthetic_timers = IsBitSet(privileges.eax, 3);
+  info->hyperv_apic_msrs = IsBitSet(privileges.eax, 4);
+  info->hyperv_hypercall_msrs = IsBitSet(privileges.eax, 5);
+  info->hyperv_vp_index = IsBitSet(privileges.eax, 6);
+  info->hyperv_reference_tsc = IsBitSet(privileges.eax, 9);
+  info->hyperv_frequency_msrs = IsBitSet(privileges.eax, 11);
+  const Leaf recommendations = SafeCpuIdEx(max_leaf, base + 4, 0);
+  info->hyperv_remote_tlb_flush = IsBitSet(recommendations.eax, 2);
+  info->hyperv_relaxed_timing = IsBitSet(recommendations.eax, 5);
+  info->hyperv_ex_processor_masks = IsBitSet(recommendations.eax, 11);
+  info->hyperv_spinlock_retries = (int)recommendations.ebx;
+}
+
+X86HypervisorInfo GetX86HypervisorInfo(void) {
+  X86HypervisorInfo info = kEmptyX86HypervisorInfo;
+  const Leaves leaves = ReadLeaves();
+  if (!IsBitSet(leaves.leaf_1.ecx, 31)) return info;
+  info.vendor = X86_HYPERVISOR_UNKNOWN;
+  for (uint32_t base = HYPERVISOR_BASE_LEAF; base <= HYPERVISOR_LAST_BASE_LEAF;
+       base += HYPERVISOR_BASE_STEP) {
+    // These leaves are not bounded by the maximum leaf of CPUID leaf 0.
+    const Leaf leaf = CpuId(base, 0);
+    char signature[13];
+    SetHypervisorSignature(leaf, signature);
+    const X86HypervisorVendor vendor = GetHypervisorVendor(signature);
+    // Some hypervisors report 0 leaves beyond the base one.
+    const uint32_t max_leaf = leaf.eax >= base ? leaf.eax : base;
+    if (base == HYPERVISOR_BASE_LEAF) {
+      info.vendor = vendor;
+      info.max_leaf = max_leaf;
+      memcpy(info.signature, signature, sizeof(info.signature));
+      // Leaf 0x40000010 holds the TSC frequency on VMware and KVM.
+      info.tsc_khz = (int)SafeCpuIdEx(max_leaf, base + 0x10, 0).eax;
+    }
+    if (vendor == X86_HYPERVISOR_KVM) ParseKvmLeaves(base, max_leaf, &info);
+    if (vendor == X86_HYPERVISOR_HYPERV)
+      ParseHypervLeaves(base, max_leaf, &info);
+    // Only hypervisors emulating Hyper-V move their own leaves up, there is
+    // no need to pay for more CPUID exits otherwise.
+    if (info.vendor != X86_HYPERVISOR_HYPERV) break;
+  }
+  return info;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Confidential computing
+////////////////////////////////////////////////////////////////////////////////
+
+static const X86ConfidentialInfo kEmptyX86ConfidentialInfo;
+
+// Signature of leaf 0x21 in TDX guests, in EBX, EDX, ECX order.
+#define CPU_FEATURES_TDX_GUEST "IntelTDX    "
+
+X86ConfidentialInfo GetX86ConfidentialInfo(void) {
+  X86ConfidentialInfo info = kEmptyX86ConfidentialInfo;
+  const Leaves leaves = ReadLeaves();
+  info.cpuid_expensive = IsCpuidCacheEnabled();
+  info.tme = IsBitSet(leaves.leaf_7.ecx, 13);
+  // https://www.amd.com/content/dam/amd/en/documents/processor-tech-docs/programmer-references/24594.pdf
+  const Leaf leaf_8000001f =
+      SafeCpuIdEx(leaves.max_cpuid_leaf_ext, 0x8000001F, 0);
+  info.sme = IsBitSet(leaf_8000001f.eax, 0);
+  info.sev = IsBitSet(leaf_8000001f.eax, 1);
+  info.sev_es = IsBitSet(leaf_8000001f.eax, 3);
+  info.sev_snp = IsBitSet(leaf_8000001f.eax, 4);
+  info.c_bit_position = ExtractBitRange(leaf_8000001f.ebx, 5, 0);
+  info.physical_address_reduction = ExtractBitRange(leaf_8000001f.ebx, 11, 6);
+  info.encrypted_guests = (int)leaf_8000001f.ecx;
+  info.min_sev_no_es_asid = (int)leaf_8000001f.edx;
+  // Confidential guests always run under a hypervisor, the OS flags seen on a
+  // host describe what it can offer to its guests.
+  if (!IsBitSet(leaves.leaf_1.ecx, 31)) return info;
+  if (IsVendor(SafeCpuIdEx(leaves.max_cpuid_leaf, 0x21, 0),
+               CPU_FEATURES_TDX_GUEST)) {
+    info.guest = X86_CC_GUEST_TDX;
+  } else {
+    info.guest = GetConfidentialGuestFromOs();
+  }
+  return info;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Definitions for introspection.
 ////////////////////////////////////////////////////////////////////////////////
-#define INTROSPECTION_TABLE                                \
-  LINE(X86_FPU, fpu, , , )                                 \
-  LINE(X86_TSC, tsc, , , )                                 \
-  LINE(X86_CX8, cx8, , , )                                 \
-  LINE(X86_CLFSH, clfsh, , , )                             \
-  LINE(X86_MMX, mmx, , , )                                 \
-  LINE(X86_AES, aes, , , )                                 \
-  LINE(X86_ERMS, erms, , , )                               \
-  LINE(X86_F16C, f16c, , , )                               \
-  LINE(X86_FMA4, fma4, , , )                               \
-  LINE(X86_FMA3, fma3, , , )                               \
-  LINE(X86_VAES, vaes, , , )                               \
-  LINE(X86_VPCLMULQDQ, vpclmulqdq, , , )                   \
-  LINE(X86_BMI1, bmi1, , , )                               \
-  LINE(X86_HLE, hle, , , )                                 \
-  LINE(X86_BMI2, bmi2, , , )                               \
-  LINE(X86_RTM, rtm, , , )                                 \
-  LINE(X86_RDSEED, rdseed, , , )                           \
-  LINE(X86_CLFLUSHOPT, clflushopt, , , )                   \
-  LINE(X86_CLWB, clwb, , , )                               \
-  LINE(X86_SSE, sse, , , )                                 \
-  LINE(X86_SSE2, sse2, , , )                               \
-  LINE(X86_SSE3, sse3, , , )                               \
-  LINE(X86_SSSE3, ssse3, , , )                             \
-  LINE(X86_SSE4_1, sse4_1, , , )                           \
-  LINE(X86_SSE4_2, sse4_2, , , )                           \
-  LINE(X86_SSE4A, sse4a, , , )                             \
-  LINE(X86_AVX, avx, , , )                                 \
-  LINE(X86_AVX_VNNI, avx_vnni, , , )                       \
-  LINE(X86_AVX2, avx2, , , )                               \
-  LINE(X86_AVX512F, avx512f, , , )                         \
-  LINE(X86_AVX512CD, avx512cd, , , )                       \
-  LINE(X86_AVX512ER, avx512er, , , )                       \
-  LINE(X86_AVX512PF, avx512pf, , , )                       \
-  LINE(X86_AVX512BW, avx512bw, , , )                       \
-  LINE(X86_AVX512DQ, avx512dq, , , )                       \
-  LINE(X86_AVX512VL, avx512vl, , , )                       \
-  LINE(X86_AVX512IFMA, avx512ifma, , , )                   \
-  LINE(X86_AVX512VBMI, avx512vbmi, , , )                   \
-  LINE(X86_AVX512VBMI2, avx512vbmi2, , , )                 \
-  LINE(X86_AVX512VNNI, avx512vnni, , , )                   \
-  LINE(X86_AVX512BITALG, avx512bitalg, , , )               \
-  LINE(X86_AVX512VPOPCNTDQ, avx512vpopcntdq, , , )         \
-  LINE(X86_AVX512_4VNNIW, avx512_4vnniw, , , )             \
-  LINE(X86_AVX512_4VBMI2, avx512_4vbmi2, , , )             \
-  LINE(X86_AVX512_SECOND_FMA, avx512_second_fma, , , )     \
-  LINE(X86_AVX512_4FMAPS, avx512_4fmaps, , , )             \
-  LINE(X86_AVX512_BF16, avx512_bf16, , , )                 \
-  LINE(X86_AVX512_VP2INTERSECT, avx512_vp2intersect, , , ) \
-  LINE(X86_AVX512_FP16, avx512_fp16, , , )                 \
-  LINE(X86_AMX_BF16, amx_bf16, , , )                       \
-  LINE(X86_AMX_TILE, amx_tile, , , )                       \
-  LINE(X86_AMX_INT8, amx_int8, , , )                       \
-  LINE(X86_AMX_FP16, amx_fp16, , , )                       \
-  LINE(X86_PCLMULQDQ, pclmulqdq, , , )                     \
-  LINE(X86_SMX, smx, , , )                                 \
-  LINE(X86_SGX, sgx, , , )                                 \
-  LINE(X86_CX16, cx16, , , )                               \
-  LINE(X86_SHA, sha, , , )                                 \
-  LINE(X86_POPCNT, popcnt, , , )                           \
-  LINE(X86_MOVBE, movbe, , , )                             \
-  LINE(X86_RDRND, rdrnd, , , )                             \
-  LINE(X86_DCA, dca, , , )                                 \
-  LINE(X86_SS, ss, , , )                                   \
-  LINE(X86_ADX, adx, , , )                                 \
-  LINE(X86_LZCNT, lzcnt, , , )                             \
-  LINE(X86_GFNI, gfni, , , )                               \
-  LINE(X86_MOVDIRI, movdiri, , , )                         \
-  LINE(X86_MOVDIR64B, movdir64b, , , )                     \
-  LINE(X86_FS_REP_MOV, fs_rep_mov, , , )                   \
-  LINE(X86_FZ_REP_MOVSB, fz_rep_movsb, , , )               \
-  LINE(X86_FS_REP_STOSB, fs_rep_stosb, , , )               \
-  LINE(X86_FS_REP_CMPSB_SCASB, fs_rep_cmpsb_scasb, , , )   \
-  LINE(X86_LAM, lam, , , )                                 \
-  LINE(X86_UAI, uai, , , )
+#define INTROSPECTION_TABLE                                                    \
+  LINE(X86_FPU, fpu, "fpu", X86_HWCAP_FPU, 0)                                  \
+  LINE(X86_TSC, tsc, "tsc", X86_HWCAP_TSC, 0)                                  \
+  LINE(X86_RDTSCP, rdtscp, "rdtscp", 0, 0)                                     \
+  LINE(X86_RDPID, rdpid, "rdpid", 0, 0)                                        \
+  LINE(X86_CX8, cx8, "cx8", X86_HWCAP_CX8, 0)                                  \
+  LINE(X86_CLFSH, clfsh, "clflush", X86_HWCAP_CLFSH, 0)                        \
+  LINE(X86_MMX, mmx, "mmx", X86_HWCAP_MMX, 0)                                  \
+  LINE(X86_AES, aes, "aes", 0, 0)                                              \
+  LINE(X86_ERMS, erms, "erms", 0, 0)                                           \
+  LINE(X86_F16C, f16c, "f16c", 0, 0)                                           \
+  LINE(X86_FMA4, fma4, "fma4", 0, 0)                                           \
+  LINE(X86_FMA3, fma3, "fma", 0, 0)                                            \
+  LINE(X86_VAES, vaes, "vaes", 0, 0)                                           \
+  LINE(X86_VPCLMULQDQ, vpclmulqdq, "vpclmulqdq", 0, 0)                         \
+  LINE(X86_BMI1, bmi1, "bmi1", 0, 0)                                           \
+  LINE(X86_HLE, hle, "hle", 0, 0)                                              \
+  LINE(X86_BMI2, bmi2, "bmi2", 0, 0)                                           \
+  LINE(X86_RTM, rtm, "rtm", 0, 0)                                              \
+  LINE(X86_RTM_ALWAYS_ABORT, rtm_always_abort, "rtm_always_abort", 0, 0)       \
+  LINE(X86_TSX_FORCE_ABORT, tsx_force_abort, "tsx_force_abort", 0, 0)          \
+  LINE(X86_RTM_USABLE, rtm_usable, "", 0, 0)                                   \
+  LINE(X86_RDSEED, rdseed, "rdseed", 0, 0)                                     \
+  LINE(X86_CLFLUSHOPT, clflushopt, "clflushopt", 0, 0)                         \
+  LINE(X86_CLWB, clwb, "clwb", 0, 0)                                           \
+  LINE(X86_CLDEMOTE, cldemote, "cldemote", 0, 0)                               \
+  LINE(X86_PREFETCHW, prefetchw, "3dnowprefetch", 0, 0)                        \
+  LINE(X86_PREFETCHI, prefetchi, "", 0, 0)                                     \
+  LINE(X86_CLZERO, clzero, "clzero", 0, 0)                                     \
+  LINE(X86_WBNOINVD, wbnoinvd, "wbnoinvd", 0, 0)                               \
+  LINE(X86_SSE, sse, "sse", X86_HWCAP_SSE, 0)                                  \
+  LINE(X86_SSE2, sse2, "sse2", X86_HWCAP_SSE2, 0)                              \
+  LINE(X86_SSE3, sse3, "pni", 0, 0)                                            \
+  LINE(X86_SSSE3, ssse3, "ssse3", 0, 0)                                        \
+  LINE(X86_SSE4_1, sse4_1, "sse4_1", 0, 0)                                     \
+  LINE(X86_SSE4_2, sse4_2, "sse4_2", 0, 0)                                     \
+  LINE(X86_SSE4A, sse4a, "sse4a", 0, 0)                                        \
+  LINE(X86_AVX, avx, "avx", 0, 0)                                              \
+  LINE(X86_AVX_VNNI, avx_vnni, "avx_vnni", 0, 0)                               \
+  LINE(X86_AVX_VNNI_INT8, avx_vnni_int8, "", 0, 0)                             \
+  LINE(X86_AVX_VNNI_INT16, avx_vnni_int16, "", 0, 0)                           \
+  LINE(X86_AVX_IFMA, avx_ifma, "avx_ifma", 0, 0)                               \
+  LINE(X86_AVX_NE_CONVERT, avx_ne_convert, "", 0, 0)                           \
+  LINE(X86_AVX2, avx2, "avx2", 0, 0)                                           \
+  LINE(X86_AVX512F, avx512f, "avx512f", 0, 0)                                  \
+  LINE(X86_AVX512CD, avx512cd, "avx512cd", 0, 0)                               \
+  LINE(X86_AVX512ER, avx512er, "avx512er", 0, 0)                               \
+  LINE(X86_AVX512PF, avx512pf, "avx512pf", 0, 0)                               \
+  LINE(X86_AVX512BW, avx512bw, "avx512bw", 0, 0)                               \
+  LINE(X86_AVX512DQ, avx512dq, "avx512dq", 0, 0)                               \
+  LINE(X86_AVX512VL, avx512vl, "avx512vl", 0, 0)                               \
+  LINE(X86_AVX512IFMA, avx512ifma, "avx512ifma", 0, 0)                         \
+  LINE(X86_AVX512VBMI, avx512vbmi, "avx512vbmi", 0, 0)                         \
+  LINE(X86_AVX512VBMI2, avx512vbmi2, "avx512_vbmi2", 0, 0)                     \
+  LINE(X86_AVX512VNNI, avx512vnni, "avx512_vnni", 0, 0)                        \
+  LINE(X86_AVX512BITALG, avx512bitalg, "avx512_bitalg", 0, 0)                  \
+  LINE(X86_AVX512VPOPCNTDQ, avx512vpopcntdq, "avx512_vpopcntdq", 0, 0)         \
+  LINE(X86_AVX512_4VNNIW, avx512_4vnniw, "avx512_4vnniw", 0, 0)                \
+  /* Matches ParseCpuId, which reads avx512_4vbmi2 from the 4fmaps bit. */     \
+  LINE(X86_AVX512_4VBMI2, avx512_4vbmi2, "avx512_4fmaps", 0, 0)                \
+  LINE(X86_AVX512_SECOND_FMA, avx512_second_fma, "", 0, 0)                     \
+  LINE(X86_AVX512_4FMAPS, avx512_4fmaps, "avx512_4fmaps", 0, 0)                \
+  LINE(X86_AVX512_BF16, avx512_bf16, "avx512_bf16", 0, 0)                      \
+  LINE(X86_AVX512_VP2INTERSECT, avx512_vp2intersect, "avx512_vp2intersect",    \
+       0, 0)                                                                   \
+  LINE(X86_AVX512_FP16, avx512_fp16, "avx512_fp16", 0, 0)                      \
+  LINE(X86_AVX10, avx10, "", 0, 0)                                             \
+  LINE(X86_AVX10_256, avx10_256, "", 0, 0)                                     \
+  LINE(X86_AVX10_512, avx10_512, "", 0, 0)                                     \
+  LINE(X86_AMX_BF16, amx_bf16, "amx_bf16", 0, 0)                               \
+  LINE(X86_AMX_TILE, amx_tile, "amx_tile", 0, 0)                               \
+  LINE(X86_AMX_INT8, amx_int8, "amx_int8", 0, 0)                               \
+  LINE(X86_AMX_FP16, amx_fp16, "amx_fp16", 0, 0)                               \
+  LINE(X86_AMX_COMPLEX, amx_complex, "", 0, 0)                                 \
+  LINE(X86_AMX_FP8, amx_fp8, "", 0, 0)                                         \
+  LINE(X86_APX_F, apx_f, "", 0, 0)                                             \
+  LINE(X86_PCLMULQDQ, pclmulqdq, "pclmulqdq", 0, 0)                            \
+  LINE(X86_SMX, smx, "smx", 0, 0)                                              \
+  LINE(X86_SGX, sgx, "sgx", 0, 0)                                              \
+  LINE(X86_CX16, cx16, "cx16", 0, 0)                                           \
+  LINE(X86_SHA, sha, "sha_ni", 0, 0)                                           \
+  LINE(X86_SHA512, sha512, "sha512", 0, 0)                                     \
+  LINE(X86_SM3, sm3, "sm3", 0, 0)                                              \
+  LINE(X86_SM4, sm4, "sm4", 0, 0)                                              \
+  LINE(X86_KL, kl, "", 0, 0)                                                   \
+  LINE(X86_AESKLE, aeskle, "", 0, 0)                                           \
+  LINE(X86_WIDE_KL, wide_kl, "", 0, 0)                                         \
+  LINE(X86_POPCNT, popcnt, "popcnt", 0, 0)                                     \
+  LINE(X86_MOVBE, movbe, "movbe", 0, 0)                                        \
+  LINE(X86_RDRND, rdrnd, "rdrand", 0, 0)                                       \
+  LINE(X86_DCA, dca, "dca", 0, 0)                                              \
+  LINE(X86_SS, ss, "ss", X86_HWCAP_SS, 0)                                      \
+  LINE(X86_HYPERVISOR, hypervisor, "hypervisor", 0, 0)                         \
+  LINE(X86_ADX, adx, "adx", 0, 0)                                              \
+  LINE(X86_LZCNT, lzcnt, "abm", 0, 0)                                          \
+  LINE(X86_GFNI, gfni, "gfni", 0, 0)                                           \
+  LINE(X86_MOVDIRI, movdiri, "movdiri", 0, 0)                                  \
+  LINE(X86_MOVDIR64B, movdir64b, "movdir64b", 0, 0)                            \
+  LINE(X86_WAITPKG, waitpkg, "waitpkg", 0, 0)                                  \
+  LINE(X86_SERIALIZE, serialize, "serialize", 0, 0)                            \
+  LINE(X86_UINTR, uintr, "", 0, 0)                                             \
+  LINE(X86_MONITORX, monitorx, "mwaitx", 0, 0)                                 \
+  LINE(X86_HRESET, hreset, "", 0, 0)                                           \
+  LINE(X86_FS_REP_MOV, fs_rep_mov, "fsrm", 0, 0)                               \
+  LINE(X86_FZ_REP_MOVSB, fz_rep_movsb, "fzrm", 0, 0)                           \
+  LINE(X86_FS_REP_STOSB, fs_rep_stosb, "fsrs", 0, 0)                           \
+  LINE(X86_FS_REP_CMPSB_SCASB, fs_rep_cmpsb_scasb, "fsrc", 0, 0)               \
+  LINE(X86_LAM, lam, "lam", 0, 0)                                              \
+  LINE(X86_UAI, uai, "", 0, 0)                                                 \
+  LINE(X86_PKU, pku, "pku", 0, 0)                                              \
+  LINE(X86_OSPKE, ospke, "ospke", 0, 0)                                        \
+  LINE(X86_FSGSBASE, fsgsbase, "fsgsbase", 0, X86_HWCAP2_FSGSBASE)
 #define INTROSPECTION_PREFIX X86
 #define INTROSPECTION_ENUM_PREFIX X86
-#include "define_introspection.inl"
+#include "define_introspection_and_hwcaps.inl"
 
 #define X86_MICROARCHITECTURE_NAMES \
   LINE(X86_UNKNOWN)                 \
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+// For syscall().
+#define _GNU_SOURCE
+
 #include "cpu_features_macros.h"
 
 #ifdef CPU_FEATURES_ARCH_X86
@@ -25,33 +28,318 @@ static void OverrideOsPreserves(OsPreserves* os_preserves) {
 }
 
 #include "internal/filesystem.h"
+#include "internal/hwcaps.h"
 #include "internal/stack_line_reader.h"
 #include "internal/string_view.h"
+
+// Fills `info` from the first processor and, when `flag` is not NULL, sets
+// `has_flag` to whether its "flags" line holds `flag`.
+typedef struct {
+  X86Info* info;
+  const char* flag;
+  bool has_flag;
+} ProcCpuInfoData;
+
+static bool HandleX86Line(const LineResult result,
+                          ProcCpuInfoData* const data) {
+  X86Info* const info = data->info;
+  StringView key, value;
+  if (CpuFeatures_StringView_GetAttributeKeyValue(result.line, &key, &value)) {
+    if (CpuFeatures_StringView_IsEquals(key, str("flags"))) {
+      for (size_t i = 0; i < X86_LAST_; ++i) {
+        kSetters[i](&info->features, CpuFeatures_StringView_HasWord(
+                                         value, kCpuInfoFlags[i], ' '));
+      }
+      if (data->flag)
+        data->has_flag = CpuFeatures_StringView_HasWord(value, data->flag, ' ');
+      // The flags come last, the other processors are not needed.
+      return false;
+    } else if (CpuFeatures_StringView_IsEquals(key, str("vendor_id"))) {
+      CpuFeatures_StringView_CopyString(value, info->vendor,
+                                        sizeof(info->vendor));
+    } else if (CpuFeatures_StringView_IsEquals(key, str("cpu family"))) {
+      info->family = CpuFeatures_StringView_ParsePositiveNumber(value);
+    } else if (CpuFeatures_StringView_IsEquals(key, str("model"))) {
+      info->model = CpuFeatures_StringView_ParsePositiveNumber(value);
+    } else if (CpuFeatures_StringView_IsEquals(key, str("stepping"))) {
+      info->stepping = CpuFeatures_StringView_ParsePositiveNumber(value);
+    } else if (CpuFeatures_StringView_IsEquals(key, str("model name"))) {
+      CpuFeatures_StringView_CopyString(value, info->brand_string,
+                                        sizeof(info->brand_string));
+    }
+  }
+  return !result.eof;
+}
+
+// Returns false if /proc/cpuinfo cannot be read.
+static bool FillProcCpuInfoData(ProcCpuInfoData* const data) {
+  const int fd = CpuFeatures_OpenFile("/proc/cpuinfo");
+  if (fd < 0) return false;
+  StackLineReader reader;
+  StackLineReader_Initialize(&reader, fd);
+  for (;;) {
+    if (!HandleX86Line(StackLineReader_NextLine(&reader), data)) {
+      break;
+    }
+  }
+  CpuFeatures_CloseFile(fd);
+  return true;
+}
+
 static void DetectFeaturesFromOs(X86Info* info, X86Features* features) {
   (void)info;
   // Handling Linux platform through /proc/cpuinfo.
-  const int fd = CpuFeatures_OpenFile("/proc/cpuinfo");
+  X86Info os_info = kEmptyX86Info;
+  ProcCpuInfoData data = {.info = &os_info};
+  if (!FillProcCpuInfoData(&data)) return;
+  features->sse = os_info.features.sse;
+  features->sse2 = os_info.features.sse2;
+  features->sse3 = os_info.features.sse3;
+  features->ssse3 = os_info.features.ssse3;
+  features->sse4_1 = os_info.features.sse4_1;
+  features->sse4_2 = os_info.features.sse4_2;
+}
+
+static bool FillX86InfoFromOs(X86Info* info) {
+  ProcCpuInfoData data = {.info = info};
+  if (!FillProcCpuInfoData(&data)) return false;
+  // The auxiliary vector reports what the flags do not, e.g. whether the
+  // kernel enabled FSGSBASE.
+  const HardwareCapabilities hwcaps = CpuFeatures_GetHardwareCapabilities();
+  for (size_t i = 0; i < X86_LAST_; ++i) {
+    if (CpuFeatures_IsHwCapsSet(kHardwareCapabilities[i], hwcaps)) {
+      kSetters[i](&info->features, true);
+    }
+  }
+  return true;
+}
+
+#if defined(CPU_FEATURES_MOCK_CPUID_X86)
+extern long LinuxArchPrctl(int option, unsigned long arg);
+extern int LinuxPkeyAlloc(unsigned int access_rights);
+extern int LinuxPkeyFree(int pkey);
+#else  // CPU_FEATURES_MOCK_CPUID_X86
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static long LinuxArchPrctl(int option, unsigned long arg) {
+#if defined(SYS_arch_prctl)
+  return syscall(SYS_arch_prctl, option, arg);
+#else
+  (void)option;
+  (void)arg;
+  return -1;
+#endif
+}
+
+static int LinuxPkeyAlloc(unsigned int access_rights) {
+#if defined(SYS_pkey_alloc)
+  return (int)syscall(SYS_pkey_alloc, 0, access_rights);
+#else
+  (void)access_rights;
+  return -1;
+#endif
+}
+
+static int LinuxPkeyFree(int pkey) {
+#if defined(SYS_pkey_free)
+  return (int)syscall(SYS_pkey_free, pkey);
+#else
+  (void)pkey;
+  return -1;
+#endif
+}
+#endif
+
+// From arch/x86/include/uapi/asm/prctl.h
+#define ARCH_GET_CPUID 0x1011
+
+static bool IsCpuidFaultingFromOs(void) {
+  // Available since Linux 4.12, returns 0 when CPUID faults.
+  return LinuxArchPrctl(ARCH_GET_CPUID, 0) == 0;
+}
+
+// From arch/x86/include/uapi/asm/prctl.h
+#define ARCH_GET_XCOMP_PERM 0x1022
+#define ARCH_REQ_XCOMP_PERM 0x1023
+#define XFEATURE_XTILEDATA 18
+
+static X86AmxPermission GetAmxPermissionFromOs(bool request) {
+  // Since Linux 5.16 tile data is disabled through XFD until the process asks
+  // for it.
+  if (request && LinuxArchPrctl(ARCH_REQ_XCOMP_PERM, XFEATURE_XTILEDATA) != 0)
+    return X86_AMX_PERMISSION_DENIED;
+  uint64_t permitted = 0;
+  if (LinuxArchPrctl(ARCH_GET_XCOMP_PERM, (unsigned long)(uintptr_t)&permitted))
+    return X86_AMX_PERMISSION_DENIED;
+  return (permitted >> XFEATURE_XTILEDATA) & 1 ? X86_AMX_PERMISSION_GRANTED
+                                              : X86_AMX_PERMISSION_DENIED;
+}
+
+// From arch/x86/include/uapi/asm/prctl.h
+#define ARCH_GET_UNTAG_MASK 0x4001
+#define ARCH_ENABLE_TAGGED_ADDR 0x4002
+#define ARCH_GET_MAX_TAG_BITS 0x4003
+
+// Returns whether the "flags" line of /proc/cpuinfo holds `flag`, -1 if the
+// file cannot be read.
+static int HasCpuInfoFlag(const char* flag) {
+  X86Info info = kEmptyX86Info;
+  ProcCpuInfoData data = {.info = &info, .flag = flag};
+  if (!FillProcCpuInfoData(&data)) return -1;
+  return data.has_flag;
+}
+
+static void GetAddressSpaceFromOs(X86AddressSpace* info) {
+  // The kernel clears la57 when it does not use 5-level paging.
+  info->la57_enabled = HasCpuInfoFlag("la57");
+  // LAM is available since Linux 6.4.
+  unsigned long max_tag_bits = 0;
+  if (LinuxArchPrctl(ARCH_GET_MAX_TAG_BITS,
+                     (unsigned long)(uintptr_t)&max_tag_bits) == 0)
+    info->max_tag_bits = (int)max_tag_bits;
+  uint64_t untag_mask = 0;
+  if (LinuxArchPrctl(ARCH_GET_UNTAG_MASK,
+                     (unsigned long)(uintptr_t)&untag_mask) == 0) {
+    info->tag_bits = 0;
+    for (uint64_t tags = ~untag_mask; tags; tags &= tags - 1) ++info->tag_bits;
+  }
+}
+
+static int EnableTaggedAddressesFromOs(int tag_bits) {
+  if (tag_bits <= 0) return -1;
+  return LinuxArchPrctl(ARCH_ENABLE_TAGGED_ADDR, (unsigned long)tag_bits) == 0
+             ? 0
+             : -1;
+}
+
+static bool IsRtmDisabledByOs(void) {
+  // The kernel clears the rtm flag when the microcode forces aborts.
+  if (HasCpuInfoFlag("rtm") == 0) return true;
+  // tsx=off and the TAA mitigation on affected parts disable TSX through
+  // IA32_TSX_CTRL.
+  // https://docs.kernel.org/admin-guide/hw-vuln/tsx_async_abort.html
+  bool disabled = false;
+  const int fd = CpuFeatures_OpenFile(
+      "/sys/devices/system/cpu/vulnerabilities/tsx_async_abort");
   if (fd >= 0) {
     StackLineReader reader;
     StackLineReader_Initialize(&reader, fd);
-    for (bool stop = false; !stop;) {
-      const LineResult result = StackLineReader_NextLine(&reader);
-      if (result.eof) stop = true;
-      const StringView line = result.line;
-      StringView key, value;
-      if (!CpuFeatures_StringView_GetAttributeKeyValue(line, &key, &value))
-        continue;
-      if (!CpuFeatures_StringView_IsEquals(key, str("flags"))) continue;
-      features->sse = CpuFeatures_StringView_HasWord(value, "sse", ' ');
-      features->sse2 = CpuFeatures_StringView_HasWord(value, "sse2", ' ');
-      features->sse3 = CpuFeatures_StringView_HasWord(value, "pni", ' ');
-      features->ssse3 = CpuFeatures_StringView_HasWord(value, "ssse3", ' ');
-      features->sse4_1 = CpuFeatures_StringView_HasWord(value, "sse4_1", ' ');
-      features->sse4_2 = CpuFeatures_StringView_HasWord(value, "sse4_2", ' ');
-      break;
-    }
+    const LineResult result = StackLineReader_NextLine(&reader);
+    disabled = CpuFeatures_StringView_StartsWith(
+        result.line, str("Mitigation: TSX disabled"));
+    CpuFeatures_CloseFile(fd);
+  }
+  return disabled;
+}
+
+static bool HasFile(const char* filename) {
+  const int fd = CpuFeatures_OpenFile(filename);
+  if (fd < 0) return false;
+  CpuFeatures_CloseFile(fd);
+  return true;
+}
+
+static X86ConfidentialGuest GetConfidentialGuestFromOs(void) {
+  // The attestation drivers register a misc device in confidential guests.
+  if (HasFile("/sys/class/misc/tdx_guest/dev")) return X86_CC_GUEST_TDX;
+  if (HasFile("/sys/class/misc/sev-guest/dev")) return X86_CC_GUEST_SEV_SNP;
+  // Otherwise rely on the memory encryption features the kernel kept.
+  if (HasCpuInfoFlag("sev_snp") > 0) return X86_CC_GUEST_SEV_SNP;
+  if (HasCpuInfoFlag("sev_es") > 0) return X86_CC_GUEST_SEV_ES;
+  if (HasCpuInfoFlag("sev") > 0) return X86_CC_GUEST_SEV;
+  return X86_CC_GUEST_NONE;
+}
+
+// From include/uapi/asm-generic/mman-common.h
+#define PKEY_DISABLE_ACCESS 0x1
+
+// x86 has 16 protection keys, key 0 is the default one.
+#define MAX_PKEYS 16
+
+static void GetProtectionKeysFromOs(ProtectionKeys* info) {
+  // Available since Linux 4.9. The keys are counted by allocating all of them
+  // and giving them back. pkey_free leaves the thread's rights untouched, the
+  // keys are allocated without access which is what the kernel gives threads
+  // for keys they did not allocate.
+  int pkeys[MAX_PKEYS];
+  int count = 0;
+  while (count < MAX_PKEYS &&
+         (pkeys[count] = LinuxPkeyAlloc(PKEY_DISABLE_ACCESS)) >= 0)
+    ++count;
+  for (int i = 0; i < count; ++i) LinuxPkeyFree(pkeys[i]);
+  info->num_keys = count;
+}
+
+// Returns the number held in a sysfs file or -1 on error.
+static int ReadSysfsNumber(const char* filename) {
+  int value = -1;
+  const int fd = CpuFeatures_OpenFile(filename);
+  if (fd >= 0) {
+    StackLineReader reader;
+    StackLineReader_Initialize(&reader, fd);
+    const LineResult result = StackLineReader_NextLine(&reader);
+    if (result.full_line)
+      value = CpuFeatures_StringView_ParsePositiveNumber(result.line);
     CpuFeatures_CloseFile(fd);
   }
+  return value;
+}
+
+static X86UmwaitControl GetUmwaitControlFromOs(void) {
+  // Available since Linux 5.3.
+  // https://www.kernel.org/doc/Documentation/ABI/testing/sysfs-devices-system-cpu
+  return (X86UmwaitControl){
+      .max_time = ReadSysfsNumber(
+          "/sys/devices/system/cpu/umwait_control/max_time"),
+      .c02_enabled = ReadSysfsNumber(
+          "/sys/devices/system/cpu/umwait_control/enable_c02"),
+  };
+}
+
+// Every PMU registered with perf_event exposes its dynamic type id.
+static int HasPerfEventSource(const char* type_filename) {
+  return ReadSysfsNumber(type_filename) >= 0;
+}
+
+static void GetProfilingInfoFromOs(X86ProfilingInfo* info) {
+  // Hybrid parts register one core PMU per core type.
+  info->perf_cpu =
+      HasPerfEventSource("/sys/bus/event_source/devices/cpu/type") ||
+      HasPerfEventSource("/sys/bus/event_source/devices/cpu_core/type");
+  info->perf_intel_pt =
+      HasPerfEventSource("/sys/bus/event_source/devices/intel_pt/type");
+  info->perf_ibs_fetch =
+      HasPerfEventSource("/sys/bus/event_source/devices/ibs_fetch/type");
+  info->perf_ibs_op =
+      HasPerfEventSource("/sys/bus/event_source/devices/ibs_op/type");
+}
+
+// Returns the number held in the first sysfs file that can be read, or -1.
+static int ReadFirstSysfsNumber(const char* filename,
+                                const char* fallback_filename) {
+  const int value = ReadSysfsNumber(filename);
+  return value >= 0 ? value : ReadSysfsNumber(fallback_filename);
+}
+
+static void GetRdtInfoFromOs(X86RdtInfo* info) {
+  // https://docs.kernel.org/arch/x86/resctrl.html
+  // With code and data prioritization enabled the cache resources are split
+  // into CODE and DATA halves.
+  info->resctrl_l3_classes =
+      ReadFirstSysfsNumber("/sys/fs/resctrl/info/L3/num_closids",
+                           "/sys/fs/resctrl/info/L3CODE/num_closids");
+  info->resctrl_l2_classes =
+      ReadFirstSysfsNumber("/sys/fs/resctrl/info/L2/num_closids",
+                           "/sys/fs/resctrl/info/L2CODE/num_closids");
+  info->resctrl_mba_classes =
+      ReadSysfsNumber("/sys/fs/resctrl/info/MB/num_closids");
+  info->resctrl_mon_rmids =
+      ReadSysfsNumber("/sys/fs/resctrl/info/L3_MON/num_rmids");
+  info->resctrl_mba_granularity =
+      ReadSysfsNumber("/sys/fs/resctrl/info/MB/bandwidth_gran");
+  info->resctrl_mba_min_bandwidth =
+      ReadSysfsNumber("/sys/fs/resctrl/info/MB/min_bandwidth");
 }
 
 #endif  // defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
@@ -54,5 +54,56 @@ static void DetectFeaturesFromOs(X86Info* info, X86Features* features) {
   // register exposed and this function will be skipped altogether.
 }
 
+static X86AmxPermission GetAmxPermissionFromOs(bool request) {
+  (void)request;
+  // Windows enables tile data on first use.
+  return X86_AMX_PERMISSION_GRANTED;
+}
+
+static X86UmwaitControl GetUmwaitControlFromOs(void) {
+  return kUnknownUmwaitControl;
+}
+
+static void GetAddressSpaceFromOs(X86AddressSpace* info) {
+  (void)info;
+  // 5-level paging and LAM are only reported by Linux.
+}
+
+static int EnableTaggedAddressesFromOs(int tag_bits) {
+  (void)tag_bits;
+  // LAM is not exposed to user space.
+  return -1;
+}
+
+static void GetProtectionKeysFromOs(ProtectionKeys* info) {
+  (void)info;
+  // pkey_alloc is Linux specific.
+}
+
+static bool IsRtmDisabledByOs(void) { return false; }
+
+static X86ConfidentialGuest GetConfidentialGuestFromOs(void) {
+  // SEV guests are only reported by Linux.
+  return X86_CC_GUEST_NONE;
+}
+
+static bool IsCpuidFaultingFromOs(void) { return false; }
+
+static bool FillX86InfoFromOs(X86Info* info) {
+  (void)info;
+  // Only Linux reports the features it enabled.
+  return false;
+}
+
+static void GetProfilingInfoFromOs(X86ProfilingInfo* info) {
+  (void)info;
+  // perf_event PMUs are Linux specific.
+}
+
+static void GetRdtInfoFromOs(X86RdtInfo* info) {
+  (void)info;
+  // resctrl is Linux specific.
+}
+
 #endif  // CPU_FEATURES_OS_WINDOWS
 #endif  // CPU_FEATURES_ARCH_X86
@@ -0,0 +1,168 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "cpu_features_resctrl.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "internal/filesystem.h"
+#include "internal/stack_line_reader.h"
+#include "internal/string_view.h"
+
+#define RESCTRL_PATH_SIZE 256
+
+static const ResctrlMonData kEmptyResctrlMonData;
+
+// Writes the path of `filename` within a monitoring group, the default group
+// when `name` is NULL. Returns false if it does not fit.
+static bool GetGroupPath(const char* name, const char* filename,
+                         char path[RESCTRL_PATH_SIZE]) {
+  const int size =
+      name ? snprintf(path, RESCTRL_PATH_SIZE,
+                      "/sys/fs/resctrl/mon_groups/%s%s", name, filename)
+           : snprintf(path, RESCTRL_PATH_SIZE, "/sys/fs/resctrl%s", filename);
+  return size >= 0 && size < RESCTRL_PATH_SIZE;
+}
+
+int CreateResctrlMonGroup(const char* name) {
+  char path[RESCTRL_PATH_SIZE];
+  if (!name || !GetGroupPath(name, "", path)) return -1;
+  return CpuFeatures_CreateDirectory(path) == 0 ? 0 : -1;
+}
+
+int RemoveResctrlMonGroup(const char* name) {
+  char path[RESCTRL_PATH_SIZE];
+  if (!name || !GetGroupPath(name, "", path)) return -1;
+  return CpuFeatures_RemoveDirectory(path) == 0 ? 0 : -1;
+}
+
+int AddTaskToResctrlMonGroup(const char* name, int tid) {
+  char path[RESCTRL_PATH_SIZE];
+  char buffer[16];
+  if (!name || !GetGroupPath(name, "/tasks", path)) return -1;
+  // The kernel expects a single id per write.
+  const int size = snprintf(buffer, sizeof(buffer), "%d\n", tid);
+  if (size < 0 || size >= (int)sizeof(buffer)) return -1;
+  const int fd = CpuFeatures_OpenFileForWriting(path);
+  if (fd < 0) return -1;
+  const int written = CpuFeatures_WriteFile(fd, buffer, (size_t)size);
+  CpuFeatures_CloseFile(fd);
+  return written == size ? 0 : -1;
+}
+
+// Counters hold a decimal number of bytes, "Unavailable" or "Error" are
+// reported when the hardware cannot provide a value.
+static int64_t ReadCounter(const char* domain_path, const char* counter) {
+  char path[RESCTRL_PATH_SIZE];
+  const int size = snprintf(path, sizeof(path), "%s/%s", domain_path, counter);
+  if (size < 0 || size >= (int)sizeof(path)) return -1;
+  int64_t value = -1;
+  const int fd = CpuFeatures_OpenFile(path);
+  if (fd >= 0) {
+    StackLineReader reader;
+    StackLineReader_Initialize(&reader, fd);
+    const LineResult result = StackLineReader_NextLine(&reader);
+    if (result.full_line)
+      value = CpuFeatures_StringView_ParsePositiveNumber64(
+          CpuFeatures_StringView_TrimWhitespace(result.line));
+    CpuFeatures_CloseFile(fd);
+  }
+  return value;
+}
+
+// Inserts `counters` keeping the domains sorted by id, directory entries come
+// in no particular order.
+static void InsertDomain(ResctrlMonData* data,
+                         const ResctrlDomainCounters* counters) {
+  int i = data->size++;
+  for (; i > 0 && data->domains[i - 1].id > counters->id; --i)
+    data->domains[i] = data->domains[i - 1];
+  data->domains[i] = *counters;
+}
+
+ResctrlMonData ReadResctrlMonData(const char* name) {
+  ResctrlMonData data = kEmptyResctrlMonData;
+  char mon_data_path[RESCTRL_PATH_SIZE];
+  if (!GetGroupPath(name, "/mon_data", mon_data_path)) return data;
+  CpuFeatures_Directory* const directory =
+      CpuFeatures_OpenDirectory(mon_data_path);
+  if (!directory) return data;
+  // There is one mon_L3_<id> directory per L3 cache, ids may not be
+  // contiguous.
+  const StringView prefix = str("mon_L3_");
+  for (const char* entry; (entry = CpuFeatures_ReadDirectory(directory));) {
+    const StringView entry_name = str(entry);
+    if (!CpuFeatures_StringView_StartsWith(entry_name, prefix)) continue;
+    const int id = CpuFeatures_StringView_ParsePositiveNumber(
+        CpuFeatures_StringView_PopFront(entry_name, prefix.size));
+    char domain_path[RESCTRL_PATH_SIZE];
+    const int size = snprintf(domain_path, sizeof(domain_path), "%s/%s",
+                              mon_data_path, entry);
+    if (id < 0 || size < 0 || size >= (int)sizeof(domain_path)) continue;
+    const ResctrlDomainCounters counters = {
+        .id = id,
+        .llc_occupancy = ReadCounter(domain_path, "llc_occupancy"),
+        .mbm_total_bytes = ReadCounter(domain_path, "mbm_total_bytes"),
+        .mbm_local_bytes = ReadCounter(domain_path, "mbm_local_bytes"),
+    };
+    if (counters.llc_occupancy < 0 && counters.mbm_total_bytes < 0 &&
+        counters.mbm_local_bytes < 0)
+      continue;
+    if (data.size == CPU_FEATURES_MAX_RESCTRL_DOMAINS) {
+      // Keep the domains with the lowest ids.
+      data.truncated = 1;
+      if (counters.id > data.domains[data.size - 1].id) continue;
+      --data.size;
+    }
+    InsertDomain(&data, &counters);
+  }
+  CpuFeatures_CloseDirectory(directory);
+  return data;
+}
+
+static int64_t GetCounterDelta(int64_t previous, int64_t current) {
+  // Counters are 64 bits wide in the kernel, they only go back when the group
+  // has been recreated.
+  if (previous < 0 || current < previous) return -1;
+  return current - previous;
+}
+
+ResctrlMonData GetResctrlMonDataDelta(const ResctrlMonData* previous,
+                                      const ResctrlMonData* current) {
+  ResctrlMonData delta = kEmptyResctrlMonData;
+  delta.truncated = current->truncated;
+  for (int i = 0; i < current->size; ++i) {
+    const ResctrlDomainCounters* const now = &current->domains[i];
+    ResctrlDomainCounters counters = {
+        .id = now->id,
+        .llc_occupancy = now->llc_occupancy,
+        .mbm_total_bytes = -1,
+        .mbm_local_bytes = -1,
+    };
+    for (int j = 0; j < previous->size; ++j) {
+      const ResctrlDomainCounters* const before = &previous->domains[j];
+      if (before->id != now->id) continue;
+      counters.mbm_total_bytes =
+          GetCounterDelta(before->mbm_total_bytes, now->mbm_total_bytes);
+      counters.mbm_local_bytes =
+          GetCounterDelta(before->mbm_local_bytes, now->mbm_local_bytes);
+      break;
+    }
+    delta.domains[delta.size++] = counters;
+  }
+  return delta;
+}
@@ -16,6 +16,7 @@
 
 #include <assert.h>
 #include <ctype.h>
+#include <limits.h>
 
 #include "copy.inl"
 #include "equals.inl"
@@ -115,32 +116,43 @@ static int HexValue(const char c) {
   return -1;
 }
 
-// Returns -1 if view contains non digits.
-static int ParsePositiveNumberWithBase(const StringView view, int base) {
-  int result = 0;
+// Returns -1 if view contains non digits or if the number exceeds max_value.
+static int64_t ParsePositiveNumberWithBase(const StringView view, int base,
+                                           int64_t max_value) {
+  int64_t result = 0;
   StringView remainder = view;
   for (; remainder.size;
        remainder = CpuFeatures_StringView_PopFront(remainder, 1)) {
     const int value = HexValue(CpuFeatures_StringView_Front(remainder));
     if (value < 0 || value >= base) return -1;
+    if (result > (max_value - value) / base) return -1;
     result = (result * base) + value;
   }
   return result;
 }
 
-int CpuFeatures_StringView_ParsePositiveNumber(const StringView view) {
+static int64_t ParsePositiveNumberUpTo(const StringView view,
+                                       int64_t max_value) {
   if (view.size) {
     const StringView hex_prefix = str("0x");
     if (CpuFeatures_StringView_StartsWith(view, hex_prefix)) {
       const StringView span_no_prefix =
           CpuFeatures_StringView_PopFront(view, hex_prefix.size);
-      return ParsePositiveNumberWithBase(span_no_prefix, 16);
+      return ParsePositiveNumberWithBase(span_no_prefix, 16, max_value);
     }
-    return ParsePositiveNumberWithBase(view, 10);
+    return ParsePositiveNumberWithBase(view, 10, max_value);
   }
   return -1;
 }
 
+int CpuFeatures_StringView_ParsePositiveNumber(const StringView view) {
+  return (int)ParsePositiveNumberUpTo(view, INT_MAX);
+}
+
+int64_t CpuFeatures_StringView_ParsePositiveNumber64(const StringView view) {
+  return ParsePositiveNumberUpTo(view, INT64_MAX);
+}
+
 void CpuFeatures_StringView_CopyString(const StringView src, char* dst,
                                        size_t dst_size) {
   if (dst_size > 0) {
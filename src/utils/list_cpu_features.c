@@ -362,6 +362,45 @@ static Node* GetCacheTypeString(CacheType cache_type) {
   CPU_FEATURES_UNREACHABLE();
 }
 
+#if defined(CPU_FEATURES_ARCH_RISCV)
+static Node* GetMisalignedAccessSpeedString(RiscvMisalignedAccessSpeed speed) {
+  switch (speed) {
+    case RISCV_MISALIGNED_UNKNOWN:
+      return CreateConstantString("unknown");
+    case RISCV_MISALIGNED_EMULATED:
+      return CreateConstantString("emulated");
+    case RISCV_MISALIGNED_SLOW:
+      return CreateConstantString("slow");
+    case RISCV_MISALIGNED_FAST:
+      return CreateConstantString("fast");
+    case RISCV_MISALIGNED_UNSUPPORTED:
+      return CreateConstantString("unsupported");
+  }
+  CPU_FEATURES_UNREACHABLE();
+}
+#endif
+
+#if defined(CPU_FEATURES_ARCH_X86)
+static void AddXSaveInfo(Node* root, const X86XSaveInfo* xsave_info) {
+  Node* map = CreateMap();
+  AddMapEntry(map, "enabled_size", CreateInt(xsave_info->enabled_size));
+  AddMapEntry(map, "max_size", CreateInt(xsave_info->max_size));
+  AddMapEntry(map, "enabled_compacted_size",
+              CreateInt(xsave_info->enabled_compacted_size));
+  AddMapEntry(root, "xsave", map);
+}
+
+static void AddProfilingInfo(Node* root, const X86ProfilingInfo* info) {
+  Node* map = CreateMap();
+  AddMapEntry(map, "pmu_version", CreateInt(info->pmu_version));
+  AddMapEntry(map, "gp_counters", CreateInt(info->gp_counters));
+  AddMapEntry(map, "gp_counter_width", CreateInt(info->gp_counter_width));
+  AddMapEntry(map, "fixed_counters", CreateInt(info->fixed_counters));
+  AddMapEntry(map, "lbr_depth", CreateInt(info->lbr_depth));
+  AddMapEntry(root, "profiling", map);
+}
+#endif
+
 static void AddCacheInfo(Node* root, const CacheInfo* cache_info) {
   Node* array = CreateArray();
   for (int i = 0; i < cache_info->size; ++i) {
@@ -384,6 +423,8 @@ static Node* CreateTree(void) {
 #if defined(CPU_FEATURES_ARCH_X86)
   const X86Info info = GetX86Info();
   const CacheInfo cache_info = GetX86CacheInfo();
+  const X86XSaveInfo xsave_info = GetX86XSaveInfo();
+  const X86ProfilingInfo profiling_info = GetX86ProfilingInfo();
   AddMapEntry(root, "arch", CreateString("x86"));
   AddMapEntry(root, "brand", CreateString(info.brand_string));
   AddMapEntry(root, "family", CreateInt(info.family));
@@ -392,8 +433,12 @@ static Node* CreateTree(void) {
   AddMapEntry(root, "uarch",
               CreateString(
                   GetX86MicroarchitectureName(GetX86Microarchitecture(&info))));
+  AddMapEntry(root, "avx10_version", CreateInt(info.avx10_version));
+  AddMapEntry(root, "avx10_max_vl", CreateInt(info.avx10_max_vl));
   AddFlags(root, &info.features);
   AddCacheInfo(root, &cache_info);
+  AddXSaveInfo(root, &xsave_info);
+  AddProfilingInfo(root, &profiling_info);
 #elif defined(CPU_FEATURES_ARCH_ARM)
   const ArmInfo info = GetArmInfo();
   AddMapEntry(root, "arch", CreateString("ARM"));
@@ -440,6 +485,13 @@ static Node* CreateTree(void) {
   AddMapEntry(root, "arch", CreateString("risc-v"));
   AddMapEntry(root, "vendor", CreateString(info.vendor));
   AddMapEntry(root, "microarchitecture", CreateString(info.uarch));
+  AddMapEntry(root, "misaligned_access_speed",
+              GetMisalignedAccessSpeedString(info.misaligned_access_speed));
+  AddMapEntry(root, "zicboz_block_size", CreateInt(info.zicboz_block_size));
+  const RiscvVectorInfo vector_info = GetRiscvVectorInfo();
+  AddMapEntry(root, "vlen", CreateInt(vector_info.vlen));
+  AddMapEntry(root, "elen", CreateInt(vector_info.elen));
+  AddMapEntry(root, "zvl", CreateInt(vector_info.zvl));
   AddFlags(root, &info.features);
 #elif defined(CPU_FEATURES_ARCH_LOONGARCH)
   const LoongArchInfo info = GetLoongArchInfo();
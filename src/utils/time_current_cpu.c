@@ -0,0 +1,74 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This program measures the cost of each mechanism CpuFeatures_GetCurrentCpu
+// can use on this host and marks the one it selects. An optional argument sets
+// the number of calls per mechanism.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "cpu_features_current_cpu.h"
+
+static const char* GetMethodName(CurrentCpuMethod method) {
+  switch (method) {
+    case CPU_FEATURE_CURRENT_CPU_RSEQ:
+      return "rseq";
+    case CPU_FEATURE_CURRENT_CPU_RDPID:
+      return "rdpid";
+    case CPU_FEATURE_CURRENT_CPU_RDTSCP:
+      return "rdtscp";
+    case CPU_FEATURE_CURRENT_CPU_OS:
+      return "os";
+    default:
+      return "none";
+  }
+}
+
+// Returns the average cost of a call in nanoseconds.
+static double TimeMethod(CurrentCpuMethod method, long iterations,
+                         long* checksum) {
+  const clock_t start = clock();
+  for (long i = 0; i < iterations; ++i)
+    *checksum += CpuFeatures_GetCurrentCpuWithMethod(method);
+  const clock_t end = clock();
+  return (double)(end - start) * 1e9 / CLOCKS_PER_SEC / (double)iterations;
+}
+
+int main(int argc, char** argv) {
+  const long iterations = argc > 1 ? atol(argv[1]) : 10000000L;
+  if (iterations <= 0) {
+    fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  // Selects the method outside of the timed loops.
+  const CurrentCpuMethod selected = CpuFeatures_GetCurrentCpuMethod();
+  // Summing the results keeps the calls from being optimized away.
+  long checksum = 0;
+  printf("iterations      : %ld\n", iterations);
+  for (int i = CPU_FEATURE_CURRENT_CPU_RSEQ; i <= CPU_FEATURE_CURRENT_CPU_OS;
+       ++i) {
+    const CurrentCpuMethod method = (CurrentCpuMethod)i;
+    printf("%-16s: ", GetMethodName(method));
+    if (!CpuFeatures_IsCurrentCpuMethodAvailable(method)) {
+      printf("unavailable\n");
+      continue;
+    }
+    printf("%.2f ns per call%s\n", TimeMethod(method, iterations, &checksum),
+           method == selected ? " (selected)" : "");
+  }
+  printf("checksum        : %ld\n", checksum);
+  return EXIT_SUCCESS;
+}
@@ -34,8 +34,32 @@ class FakeCpuAarch64 {
 
   void SetMidrEl1(uint64_t midr_el1) { _midr_el1 = midr_el1; }
 
+  long GetTaggedAddrCtrl() const { return tagged_addr_ctrl_; }
+
+  void SetTaggedAddrCtrl(long tagged_addr_ctrl) {
+    tagged_addr_ctrl_ = tagged_addr_ctrl;
+  }
+
+  int LinuxPkeyAlloc(unsigned int access_rights) {
+    pkey_access_rights_ = access_rights;
+    for (int pkey = 1; pkey < num_pkeys_; ++pkey) {
+      if (allocated_pkeys_.insert(pkey).second) return pkey;
+    }
+    return -1;
+  }
+
+  int LinuxPkeyFree(int pkey) { return allocated_pkeys_.erase(pkey) ? 0 : -1; }
+
+  void SetNumPkeys(int num_pkeys) { num_pkeys_ = num_pkeys; }
+
+  unsigned int GetPkeyAccessRights() const { return pkey_access_rights_; }
+
  private:
   uint64_t _midr_el1;
+  long tagged_addr_ctrl_ = -1;
+  int num_pkeys_ = 0;
+  unsigned int pkey_access_rights_ = 0;
+  std::set<int> allocated_pkeys_;
 #elif defined(CPU_FEATURES_OS_MACOS)
   std::set<std::string> darwin_sysctlbyname_;
   std::map<std::string, int> darwin_sysctlbynamevalue_;
@@ -91,6 +115,16 @@ static FakeCpuAarch64& cpu() {
 // Define OS dependent mock functions
 #if defined(CPU_FEATURES_OS_FREEBSD) || defined(CPU_FEATURES_OS_OPENBSD) || defined(CPU_FEATURES_OS_LINUX)
 extern "C" uint64_t GetMidrEl1(void) { return cpu().GetMidrEl1(); }
+
+extern "C" long LinuxPrctl(int option) {
+  return option == 56 ? cpu().GetTaggedAddrCtrl() : -1;
+}
+
+extern "C" int LinuxPkeyAlloc(unsigned int access_rights) {
+  return cpu().LinuxPkeyAlloc(access_rights);
+}
+
+extern "C" int LinuxPkeyFree(int pkey) { return cpu().LinuxPkeyFree(pkey); }
 #elif defined(CPU_FEATURES_OS_MACOS)
 extern "C" bool GetDarwinSysCtlByName(const char* name) {
   return cpu().GetDarwinSysCtlByName(name);
@@ -136,6 +170,26 @@ TEST_F(CpuidAarch64Test, Aarch64FeaturesEnum) {
   }
 }
 
+TEST_F(CpuidAarch64Test, CryptoFeatures) {
+  Aarch64Features features{};
+  features.aes = true;
+  features.pmull = true;
+  features.sha1 = true;
+  features.sha2 = true;
+  features.sha512 = true;
+  features.sm4 = true;
+  const auto crypto = GetAarch64CryptoFeatures(&features);
+  EXPECT_TRUE(crypto.aes);
+  EXPECT_TRUE(crypto.clmul);
+  EXPECT_TRUE(crypto.sha1);
+  EXPECT_TRUE(crypto.sha256);
+  EXPECT_TRUE(crypto.sha512);
+  EXPECT_FALSE(crypto.sha3);
+  EXPECT_FALSE(crypto.sm3);
+  EXPECT_TRUE(crypto.sm4);
+  EXPECT_FALSE(crypto.aes_wrapped_key);
+}
+
 // AT_HWCAP tests
 #if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_FREEBSD) || defined(CPU_FEATURES_OS_OPENBSD)
 TEST_F(CpuidAarch64Test, FromHardwareCap) {
@@ -209,6 +263,120 @@ TEST_F(CpuidAarch64Test, FromHardwareCap2) {
 
 // OS dependent tests
 #if defined(CPU_FEATURES_OS_LINUX)
+TEST_F(CpuidAarch64Test, TaggedAddressControl) {
+  // PR_TAGGED_ADDR_ENABLE | PR_MTE_TCF_SYNC with tags 1 to 15 allowed.
+  cpu().SetTaggedAddrCtrl(0x1 | 0x2 | (0xFFFE << 3));
+  const auto info = GetAarch64TaggedAddressControl();
+  EXPECT_EQ(info.tagged_addr_enabled, 1);
+  EXPECT_EQ(info.mte_tcf_sync, 1);
+  EXPECT_EQ(info.mte_tcf_async, 0);
+  EXPECT_EQ(info.mte_tag_mask, 0xFFFE);
+}
+
+TEST_F(CpuidAarch64Test, TaggedAddressControlUnavailable) {
+  const auto info = GetAarch64TaggedAddressControl();
+  EXPECT_EQ(info.tagged_addr_enabled, -1);
+  EXPECT_EQ(info.mte_tag_mask, -1);
+}
+
+TEST_F(CpuidAarch64Test, ProtectionKeys) {
+  ResetHwcaps();
+  SetHardwareCapabilities(AARCH64_HWCAP_FP, AARCH64_HWCAP2_POE);
+  GetEmptyFilesystem();
+  cpu().SetNumPkeys(8);
+  const auto pkeys = GetAarch64ProtectionKeys();
+  EXPECT_TRUE(pkeys.supported);
+  EXPECT_EQ(pkeys.num_keys, 7);
+  // PKEY_DISABLE_ACCESS, the thread keeps no rights on the probed keys.
+  EXPECT_EQ(cpu().GetPkeyAccessRights(), 0x1);
+}
+
+TEST_F(CpuidAarch64Test, ProtectionKeysWithoutPoe) {
+  ResetHwcaps();
+  SetHardwareCapabilities(AARCH64_HWCAP_FP, 0);
+  GetEmptyFilesystem();
+  const auto pkeys = GetAarch64ProtectionKeys();
+  EXPECT_FALSE(pkeys.supported);
+  EXPECT_EQ(pkeys.num_keys, -1);
+}
+
+TEST_F(CpuidAarch64Test, HugePagesWith4KGranule) {
+  ResetHwcaps();
+  SetPageSize(4096);
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/sys/kernel/mm/transparent_hugepage/enabled",
+                "[always] madvise never\n");
+  fs.CreateFile("/sys/kernel/mm/transparent_hugepage/defrag",
+                "always defer defer+madvise [madvise] never\n");
+  fs.CreateFile("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size",
+                "2097152\n");
+  fs.CreateFile("/sys/kernel/mm/hugepages/hugepages-2048kB/nr_hugepages",
+                "128\n");
+  fs.CreateFile("/sys/kernel/mm/hugepages/hugepages-2048kB/free_hugepages",
+                "100\n");
+  const auto info = GetAarch64HugePageInfo();
+  EXPECT_EQ(info.page_size, 4096);
+  EXPECT_EQ(info.thp_enabled, CPU_FEATURE_THP_ALWAYS);
+  EXPECT_EQ(info.thp_defrag, CPU_FEATURE_THP_DEFRAG_MADVISE);
+  EXPECT_EQ(info.thp_size_kb, 2048);
+  ASSERT_EQ(info.size, 4);
+  EXPECT_EQ(info.sizes[0].size_kb, 64);
+  EXPECT_EQ(info.sizes[0].total, -1);
+  EXPECT_EQ(info.sizes[1].size_kb, 2048);
+  EXPECT_EQ(info.sizes[1].total, 128);
+  EXPECT_EQ(info.sizes[1].free, 100);
+  EXPECT_EQ(info.sizes[1].node_total[0], -1);
+  EXPECT_EQ(info.sizes[2].size_kb, 32 * 1024);
+  EXPECT_EQ(info.sizes[3].size_kb, 1024 * 1024);
+}
+
+TEST_F(CpuidAarch64Test, HugePagesWith64KGranule) {
+  ResetHwcaps();
+  SetPageSize(65536);
+  GetEmptyFilesystem();
+  const auto info = GetAarch64HugePageInfo();
+  EXPECT_EQ(info.page_size, 65536);
+  EXPECT_EQ(info.thp_enabled, CPU_FEATURE_THP_UNKNOWN);
+  EXPECT_EQ(info.thp_size_kb, 0);
+  ASSERT_EQ(info.size, 3);
+  EXPECT_EQ(info.sizes[0].size_kb, 2048);
+  EXPECT_EQ(info.sizes[1].size_kb, 512 * 1024);
+  EXPECT_EQ(info.sizes[2].size_kb, 16 * 1024 * 1024);
+}
+
+TEST_F(CpuidAarch64Test, FeaturesFromHardwareCapOnly) {
+  ResetHwcaps();
+  SetHardwareCapabilities(AARCH64_HWCAP_FP | AARCH64_HWCAP_ASIMD,
+                          AARCH64_HWCAP2_SVE2);
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(processor       : 0
+Features        : fp asimd aes crc32
+CPU implementer : 0x41
+CPU part        : 0xd03)");
+  const auto features = GetAarch64Features();
+  EXPECT_TRUE(features.fp);
+  EXPECT_TRUE(features.asimd);
+  EXPECT_TRUE(features.sve2);
+  // /proc/cpuinfo is not read.
+  EXPECT_FALSE(features.aes);
+  EXPECT_FALSE(features.crc32);
+}
+
+TEST_F(CpuidAarch64Test, FeaturesFallBackToCpuInfoWithoutHardwareCap) {
+  ResetHwcaps();
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(processor       : 0
+Features        : fp asimd aes crc32
+CPU implementer : 0x41
+CPU part        : 0xd03)");
+  const auto features = GetAarch64Features();
+  EXPECT_TRUE(features.fp);
+  EXPECT_TRUE(features.asimd);
+  EXPECT_TRUE(features.aes);
+  EXPECT_TRUE(features.crc32);
+  EXPECT_FALSE(features.sve2);
+}
+
 TEST_F(CpuidAarch64Test, ARMCortexA53) {
   ResetHwcaps();
   auto& fs = GetEmptyFilesystem();
@@ -331,6 +499,18 @@ CPU revision    : 3)");
   EXPECT_FALSE(info.features.smesf8dp4);
   EXPECT_FALSE(info.features.smesf8dp2);
   EXPECT_FALSE(info.features.poe);
+  EXPECT_FALSE(info.features.mtefar);
+  EXPECT_FALSE(info.features.mtestoreonly);
+}
+
+TEST_F(CpuidAarch64Test, FromHardwareCap3) {
+  ResetHwcaps();
+  SetHardwareCapabilities(AARCH64_HWCAP_FP, 0, AARCH64_HWCAP3_MTE_FAR);
+  GetEmptyFilesystem();  // disabling /proc/cpuinfo
+  const auto info = GetAarch64Info();
+  EXPECT_TRUE(info.features.fp);
+  EXPECT_TRUE(info.features.mtefar);
+  EXPECT_FALSE(info.features.mtestoreonly);
 }
 #elif defined(CPU_FEATURES_OS_MACOS)
 TEST_F(CpuidAarch64Test, FromDarwinSysctlFromName) {
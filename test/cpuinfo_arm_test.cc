@@ -380,5 +380,64 @@ Serial		: 0000000000000000)");
   EXPECT_TRUE(info.features.idiva);
 }
 
+TEST(CpuinfoArmTest, FeaturesFromHardwareCapOnArmv8Platform) {
+  ResetHwcaps();
+  SetHardwareCapabilities(ARM_HWCAP_NEON | ARM_HWCAP_IDIVA, ARM_HWCAP2_AES);
+  SetPlatformPointer("v8l");
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(processor       : 0
+Features        : half thumb fastmult vfp edsp neon vfpv3 tls vfpv4 idiva idivt
+CPU implementer : 0x41
+CPU architecture: 8
+CPU variant     : 0x0
+CPU part        : 0xd03
+CPU revision    : 4)");
+  const auto features = GetArmFeatures();
+  EXPECT_TRUE(features.neon);
+  EXPECT_TRUE(features.idiva);
+  EXPECT_TRUE(features.aes);
+  EXPECT_TRUE(features.vfpv3);  // triggered by neon
+  EXPECT_TRUE(features.vfp);    // triggered by vfpv3
+  // /proc/cpuinfo is not read.
+  EXPECT_FALSE(features.vfpv4);
+  EXPECT_FALSE(features.idivt);
+}
+
+TEST(CpuinfoArmTest, FeaturesFromHardwareCapWithoutKnownQuirks) {
+  ResetHwcaps();
+  SetHardwareCapabilities(ARM_HWCAP_VFPV4 | ARM_HWCAP_IDIVA | ARM_HWCAP_IDIVT,
+                          0);
+  SetPlatformPointer("v7l");
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(processor       : 0
+Features        : half thumb vfp vfpv3 vfpv4 idiva idivt lpae
+CPU implementer : 0x41
+CPU architecture: 7)");
+  const auto features = GetArmFeatures();
+  EXPECT_TRUE(features.vfpv4);
+  EXPECT_TRUE(features.vfpv3);  // triggered by vfpv4
+  EXPECT_TRUE(features.vfp);    // triggered by vfpv3
+  // /proc/cpuinfo is not read.
+  EXPECT_FALSE(features.lpae);
+}
+
+// The quirks in GetArmInfo need /proc/cpuinfo to identify the faulty cores.
+TEST(CpuinfoArmTest, FeaturesFromCpuInfoWhenQuirksMayApply) {
+  ResetHwcaps();
+  SetHardwareCapabilities(ARM_HWCAP_NEON, 0);
+  SetPlatformPointer("v7l");
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo",
+                R"(CPU implementer  : 0x51
+CPU architecture: 7
+CPU variant : 0x1
+CPU part  : 0x06f
+CPU revision  : 0)");
+  const auto features = GetArmFeatures();
+  EXPECT_TRUE(features.neon);
+  EXPECT_TRUE(features.idiva);
+  EXPECT_TRUE(features.idivt);
+}
+
 }  // namespace
 }  // namespace cpu_features
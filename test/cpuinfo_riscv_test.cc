@@ -14,14 +14,84 @@
 
 #include "cpuinfo_riscv.h"
 
+#include <map>
+
 #include "filesystem_for_testing.h"
 #include "gtest/gtest.h"
 #include "hwcaps_for_testing.h"
+#include "internal/cpuid_riscv.h"
+#include "internal/hwcaps.h"
+#include "internal/hwprobe_riscv.h"
 
 namespace cpu_features {
+
+class FakeCpuRiscv {
+ public:
+  // The syscall is reported as unavailable until a key is set.
+  int GetRiscvHwprobe(RiscvHwprobePair* pairs, size_t pair_count) const {
+    if (values_.empty()) return -1;
+    for (size_t i = 0; i < pair_count; ++i) {
+      const auto iter = values_.find(pairs[i].key);
+      if (iter == values_.end()) {
+        pairs[i].key = -1;
+        pairs[i].value = 0;
+      } else {
+        pairs[i].value = iter->second;
+      }
+    }
+    return 0;
+  }
+
+  void SetKey(int64_t key, uint64_t value) { values_[key] = value; }
+
+  uint64_t GetRiscvVlenb() const { return vlenb_; }
+
+  void SetVlenb(uint64_t vlenb) { vlenb_ = vlenb; }
+
+  long GetRiscvVectorControl() const { return vector_control_; }
+
+  void SetVectorControl(long vector_control) {
+    vector_control_ = vector_control;
+  }
+
+ private:
+  std::map<int64_t, uint64_t> values_;
+  uint64_t vlenb_ = 0;
+  long vector_control_ = -1;
+};
+
+static FakeCpuRiscv* g_fake_cpu_instance = nullptr;
+
+static FakeCpuRiscv& cpu() {
+  assert(g_fake_cpu_instance != nullptr);
+  return *g_fake_cpu_instance;
+}
+
+extern "C" int GetRiscvHwprobe(RiscvHwprobePair* pairs, size_t pair_count) {
+  return cpu().GetRiscvHwprobe(pairs, pair_count);
+}
+
+extern "C" uint64_t GetRiscvVlenb(void) { return cpu().GetRiscvVlenb(); }
+
+extern "C" long GetRiscvVectorControl(void) {
+  return cpu().GetRiscvVectorControl();
+}
+
 namespace {
 
-TEST(CpuinfoRiscvTest, Sipeed_Lichee_RV_FromCpuInfo) {
+class CpuinfoRiscvTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    assert(g_fake_cpu_instance == nullptr);
+    g_fake_cpu_instance = new FakeCpuRiscv();
+  }
+  void TearDown() override {
+    delete g_fake_cpu_instance;
+    g_fake_cpu_instance = nullptr;
+  }
+};
+
+TEST_F(CpuinfoRiscvTest, Sipeed_Lichee_RV_FromCpuInfo) {
   ResetHwcaps();
   auto& fs = GetEmptyFilesystem();
   fs.CreateFile("/proc/cpuinfo", R"(processor	: 0 
@@ -45,7 +115,7 @@ uarch : thead,c906)");
 }
 
 // https://github.com/ThomasKaiser/sbc-bench/blob/284e82b016ec1beeac42a5fcbe556b670f68441a/results/Kendryte-K510-4.17.0.cpuinfo
-TEST(CpuinfoRiscvTest, Kendryte_K510_FromCpuInfo) {
+TEST_F(CpuinfoRiscvTest, Kendryte_K510_FromCpuInfo) {
   ResetHwcaps();
   auto& fs = GetEmptyFilesystem();
   fs.CreateFile("/proc/cpuinfo", R"(
@@ -55,7 +125,7 @@ mmu	: sv39
 
 hart	: 1
 isa	: rv64i2p0m2p0a2p0f2p0d2p0c2p0xv5-0p0
-mmu	: sv39");
+mmu	: sv39)");
   const auto info = GetRiscvInfo();
   EXPECT_STREQ(info.uarch, "");
   EXPECT_STREQ(info.vendor, "");
@@ -72,7 +142,7 @@ mmu	: sv39");
 }
 
 // https://github.com/ThomasKaiser/sbc-bench/blob/284e82b016ec1beeac42a5fcbe556b670f68441a/results/T-Head-C910-5.10.4.cpuinfo
-TEST(CpuinfoRiscvTest, T_Head_C910_FromCpuInfo) {
+TEST_F(CpuinfoRiscvTest, T_Head_C910_FromCpuInfo) {
   ResetHwcaps();
   auto& fs = GetEmptyFilesystem();
   fs.CreateFile("/proc/cpuinfo", R"(
@@ -98,7 +168,7 @@ cpu-dcache	: 64KB
 cpu-l2cache	: 2MB
 cpu-tlb		: 1024 4-ways
 cpu-cacheline	: 64Bytes
-cpu-vector	: 0.7.1");
+cpu-vector	: 0.7.1)");
   const auto info = GetRiscvInfo();
   EXPECT_STREQ(info.uarch, "");
   EXPECT_STREQ(info.vendor, "");
@@ -114,7 +184,7 @@ cpu-vector	: 0.7.1");
   EXPECT_FALSE(info.features.V);
 }
 
-TEST(CpuinfoRiscvTest, UnknownFromCpuInfo) {
+TEST_F(CpuinfoRiscvTest, UnknownFromCpuInfo) {
   ResetHwcaps();
   auto& fs = GetEmptyFilesystem();
   fs.CreateFile("/proc/cpuinfo", R"(
@@ -156,7 +226,7 @@ uarch     : sifive,bullet0)");
   EXPECT_FALSE(info.features.V);
 }
 
-TEST(CpuinfoRiscvTest, QemuCpuInfo) {
+TEST_F(CpuinfoRiscvTest, QemuCpuInfo) {
   ResetHwcaps();
   auto& fs = GetEmptyFilesystem();
   fs.CreateFile("/proc/cpuinfo", R"(
@@ -174,6 +244,299 @@ mmu		: sv48)");
   EXPECT_FALSE(info.features.Q);
   EXPECT_TRUE(info.features.C);
   EXPECT_TRUE(info.features.V);
+  EXPECT_TRUE(info.features.Zba);
+  EXPECT_TRUE(info.features.Zbb);
+  EXPECT_TRUE(info.features.Zbc);
+  EXPECT_TRUE(info.features.Zbs);
+  EXPECT_FALSE(info.features.Zicsr);
+}
+
+// Extensions of a SpacemiT K1 as reported by Linux 6.6, the multi-letter ones
+// are not listed in a canonical order.
+TEST_F(CpuinfoRiscvTest, MultiLetterExtensionsFromCpuInfo) {
+  ResetHwcaps();
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(
+processor	: 0
+hart		: 0
+model name	: Spacemit(R) X60
+isa		: rv64imafdcv_zicbom_zicboz_zicntr_zicond_zicsr_zifencei_zihintpause_zihpm_zfh_zfhmin_zca_zcd_zba_zbb_zbc_zbs_zkt_zve32f_zve32x_zve64d_zve64f_zve64x_zvfh_zvfhmin_zvkt_sscofpmf_sstc_svinval_svnapot_svpbmt
+mmu		: sv39)");
+  const auto info = GetRiscvInfo();
+  EXPECT_TRUE(info.features.RV64I);
+  EXPECT_TRUE(info.features.M);
+  EXPECT_TRUE(info.features.A);
+  EXPECT_TRUE(info.features.F);
+  EXPECT_TRUE(info.features.D);
+  EXPECT_TRUE(info.features.C);
+  EXPECT_TRUE(info.features.V);
+  EXPECT_TRUE(info.features.Zicbom);
+  EXPECT_TRUE(info.features.Zicboz);
+  EXPECT_TRUE(info.features.Zicond);
+  EXPECT_TRUE(info.features.Zicsr);
+  EXPECT_TRUE(info.features.Zifencei);
+  EXPECT_TRUE(info.features.Zihintpause);
+  EXPECT_TRUE(info.features.Zfh);
+  EXPECT_TRUE(info.features.Zfhmin);
+  EXPECT_TRUE(info.features.Zba);
+  EXPECT_TRUE(info.features.Zbb);
+  EXPECT_TRUE(info.features.Zbc);
+  EXPECT_TRUE(info.features.Zbs);
+  EXPECT_TRUE(info.features.Zkt);
+  EXPECT_TRUE(info.features.Zvfh);
+  EXPECT_TRUE(info.features.Zvfhmin);
+  EXPECT_TRUE(info.features.Zvkt);
+
+  EXPECT_FALSE(info.features.Q);
+  EXPECT_FALSE(info.features.Zbkb);
+  EXPECT_FALSE(info.features.Zknd);
+  EXPECT_FALSE(info.features.Zvbb);
+  EXPECT_FALSE(info.features.Zvkned);
+  EXPECT_FALSE(info.features.XTheadVector);
+}
+
+TEST_F(CpuinfoRiscvTest, VersionedAndVendorExtensionsFromCpuInfo) {
+  ResetHwcaps();
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(
+processor	: 0
+hart		: 0
+isa		: rv64gc2p0_zbkb1p0_zknd_zkne_zknh_zvkned_zvknhb1p0_zvbb_xtheadba_xtheadbb_xtheadbs_xtheadcondmov_xtheadvector
+mmu		: sv39)");
+  const auto info = GetRiscvInfo();
+  EXPECT_TRUE(info.features.RV64I);
+  // G expands to IMAFD_Zicsr_Zifencei.
+  EXPECT_TRUE(info.features.M);
+  EXPECT_TRUE(info.features.A);
+  EXPECT_TRUE(info.features.F);
+  EXPECT_TRUE(info.features.D);
+  EXPECT_TRUE(info.features.Zicsr);
+  EXPECT_TRUE(info.features.Zifencei);
+  EXPECT_TRUE(info.features.C);
+  EXPECT_FALSE(info.features.V);
+
+  EXPECT_TRUE(info.features.Zbkb);
+  EXPECT_TRUE(info.features.Zknd);
+  EXPECT_TRUE(info.features.Zkne);
+  EXPECT_TRUE(info.features.Zknh);
+  EXPECT_TRUE(info.features.Zvkned);
+  EXPECT_TRUE(info.features.Zvknhb);
+  EXPECT_TRUE(info.features.Zvbb);
+  EXPECT_FALSE(info.features.Zvknha);
+
+  EXPECT_TRUE(info.features.XTheadBa);
+  EXPECT_TRUE(info.features.XTheadBb);
+  EXPECT_TRUE(info.features.XTheadBs);
+  EXPECT_TRUE(info.features.XTheadCondMov);
+  EXPECT_TRUE(info.features.XTheadVector);
+}
+
+TEST_F(CpuinfoRiscvTest, FromHwprobe) {
+  ResetHwcaps();
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(
+processor	: 0
+hart		: 0
+isa		: rv64imafdc_zicsr_zifencei
+mmu		: sv39
+uarch		: sifive,u74-mc)");
+  cpu().SetKey(RISCV_HWPROBE_KEY_BASE_BEHAVIOR,
+               RISCV_HWPROBE_BASE_BEHAVIOR_IMA);
+  cpu().SetKey(RISCV_HWPROBE_KEY_IMA_EXT_0,
+               RISCV_HWPROBE_IMA_C | RISCV_HWPROBE_IMA_V |
+                   RISCV_HWPROBE_EXT_ZICBOZ | RISCV_HWPROBE_EXT_ZBA |
+                   RISCV_HWPROBE_EXT_ZVKNHB | RISCV_HWPROBE_EXT_ZICBOM);
+  cpu().SetKey(RISCV_HWPROBE_KEY_CPUPERF_0, 3);
+  cpu().SetKey(RISCV_HWPROBE_KEY_ZICBOZ_BLOCK_SIZE, 64);
+  const auto info = GetRiscvInfo();
+  EXPECT_STREQ(info.uarch, "u74-mc");
+  EXPECT_STREQ(info.vendor, "sifive");
+
+  EXPECT_FALSE(info.features.RV32I);
+  EXPECT_TRUE(info.features.RV64I);
+  EXPECT_TRUE(info.features.M);
+  EXPECT_TRUE(info.features.A);
+  // The isa string is not parsed when hwprobe is available.
+  EXPECT_FALSE(info.features.F);
+  EXPECT_FALSE(info.features.D);
+  EXPECT_TRUE(info.features.C);
+  EXPECT_TRUE(info.features.V);
+  EXPECT_TRUE(info.features.Zicsr);
+  EXPECT_TRUE(info.features.Zifencei);
+  EXPECT_TRUE(info.features.Zicboz);
+  EXPECT_TRUE(info.features.Zicbom);
+  EXPECT_TRUE(info.features.Zba);
+  EXPECT_TRUE(info.features.Zvknhb);
+  EXPECT_FALSE(info.features.Zbb);
+  EXPECT_FALSE(info.features.Zvknha);
+
+  EXPECT_EQ(info.misaligned_access_speed, RISCV_MISALIGNED_FAST);
+  EXPECT_EQ(info.zicboz_block_size, 64);
+}
+
+TEST_F(CpuinfoRiscvTest, VendorExtensionsWithHwprobe) {
+  ResetHwcaps();
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(
+processor	: 0
+hart		: 0
+isa		: rv64imafdc_zicntr_zicsr_zifencei_zihpm_xtheadba_xtheadbb_xtheadbs_xtheadcondmov
+mmu		: sv39
+uarch		: thead,c910)");
+  cpu().SetKey(RISCV_HWPROBE_KEY_BASE_BEHAVIOR,
+               RISCV_HWPROBE_BASE_BEHAVIOR_IMA);
+  cpu().SetKey(RISCV_HWPROBE_KEY_IMA_EXT_0, RISCV_HWPROBE_IMA_C);
+  cpu().SetKey(RISCV_HWPROBE_KEY_VENDOR_EXT_THEAD_0,
+               RISCV_HWPROBE_VENDOR_EXT_XTHEADVECTOR);
+  const auto info = GetRiscvInfo();
+  EXPECT_TRUE(info.features.C);
+  // hwprobe has a bit for F and D, the isa string does not override it.
+  EXPECT_FALSE(info.features.F);
+  EXPECT_FALSE(info.features.D);
+
+  EXPECT_TRUE(info.features.XTheadBa);
+  EXPECT_TRUE(info.features.XTheadBb);
+  EXPECT_TRUE(info.features.XTheadBs);
+  EXPECT_TRUE(info.features.XTheadCondMov);
+  EXPECT_TRUE(info.features.XTheadVector);
+}
+
+TEST_F(CpuinfoRiscvTest, IsaOnlyExtensionsWithHwprobe) {
+  ResetHwcaps();
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(
+processor	: 0
+hart		: 0
+isa		: rv64imafdcqv_zicond_zvl32b_zvl64b_zvl128b_zvl256b
+mmu		: sv39)");
+  cpu().SetKey(RISCV_HWPROBE_KEY_BASE_BEHAVIOR,
+               RISCV_HWPROBE_BASE_BEHAVIOR_IMA);
+  cpu().SetKey(RISCV_HWPROBE_KEY_IMA_EXT_0,
+               RISCV_HWPROBE_IMA_FD | RISCV_HWPROBE_IMA_C);
+  const auto info = GetRiscvInfo();
+  EXPECT_TRUE(info.features.F);
+  EXPECT_TRUE(info.features.C);
+  // hwprobe has no bit for Q and Zvl*b.
+  EXPECT_TRUE(info.features.Q);
+  EXPECT_TRUE(info.features.Zvl32b);
+  EXPECT_TRUE(info.features.Zvl256b);
+  EXPECT_FALSE(info.features.Zvl512b);
+  // hwprobe has a bit for V and Zicond and reports neither.
+  EXPECT_FALSE(info.features.V);
+  EXPECT_FALSE(info.features.Zicond);
+}
+
+TEST_F(CpuinfoRiscvTest, MisalignedScalarPerfSupersedesCpuPerf) {
+  ResetHwcaps();
+  GetEmptyFilesystem();
+  cpu().SetKey(RISCV_HWPROBE_KEY_BASE_BEHAVIOR,
+               RISCV_HWPROBE_BASE_BEHAVIOR_IMA);
+  cpu().SetKey(RISCV_HWPROBE_KEY_IMA_EXT_0, RISCV_HWPROBE_IMA_FD);
+  cpu().SetKey(RISCV_HWPROBE_KEY_CPUPERF_0, 0);
+  cpu().SetKey(RISCV_HWPROBE_KEY_MISALIGNED_SCALAR_PERF, 1);
+  cpu().SetKey(RISCV_HWPROBE_KEY_ZICBOZ_BLOCK_SIZE, 64);
+  const auto info = GetRiscvInfo();
+  EXPECT_TRUE(info.features.F);
+  EXPECT_TRUE(info.features.D);
+  EXPECT_FALSE(info.features.C);
+  EXPECT_FALSE(info.features.V);
+
+  EXPECT_EQ(info.misaligned_access_speed, RISCV_MISALIGNED_EMULATED);
+  // Zicboz is not reported.
+  EXPECT_EQ(info.zicboz_block_size, 0);
+}
+
+TEST_F(CpuinfoRiscvTest, FallsBackToCpuInfoWithoutHwprobe) {
+  ResetHwcaps();
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(
+processor	: 0
+hart		: 0
+isa		: rv64imafdc
+mmu		: sv39)");
+  const auto info = GetRiscvInfo();
+  EXPECT_TRUE(info.features.F);
+  EXPECT_TRUE(info.features.D);
+  EXPECT_EQ(info.misaligned_access_speed, RISCV_MISALIGNED_UNKNOWN);
+  EXPECT_EQ(info.zicboz_block_size, 0);
+}
+
+TEST_F(CpuinfoRiscvTest, VectorInfoFromHwprobe) {
+  ResetHwcaps();
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(
+processor	: 0
+hart		: 0
+isa		: rv64imafdcv_zvl32b_zvl64b_zvl128b_zvl256b
+mmu		: sv39)");
+  cpu().SetKey(RISCV_HWPROBE_KEY_BASE_BEHAVIOR,
+               RISCV_HWPROBE_BASE_BEHAVIOR_IMA);
+  cpu().SetKey(RISCV_HWPROBE_KEY_IMA_EXT_0,
+               RISCV_HWPROBE_IMA_V | RISCV_HWPROBE_EXT_ZVE32X |
+                   RISCV_HWPROBE_EXT_ZVE32F | RISCV_HWPROBE_EXT_ZVE64X |
+                   RISCV_HWPROBE_EXT_ZVE64F | RISCV_HWPROBE_EXT_ZVE64D);
+  SetHardwareCapabilities(RISCV_HWCAP_V, 0);
+  cpu().SetVectorControl(PR_RISCV_V_VSTATE_CTRL_ON);
+  cpu().SetVlenb(32);
+  const auto features = GetRiscvInfo().features;
+  EXPECT_TRUE(features.Zve32x);
+  EXPECT_TRUE(features.Zve64d);
+  EXPECT_TRUE(features.Zvl256b);
+  EXPECT_FALSE(features.Zvl512b);
+
+  const auto info = GetRiscvVectorInfo();
+  EXPECT_EQ(info.vlen, 256);
+  EXPECT_EQ(info.elen, 64);
+  EXPECT_EQ(info.zvl, 256);
+}
+
+TEST_F(CpuinfoRiscvTest, VectorInfoFromCpuInfo) {
+  ResetHwcaps();
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(
+processor	: 0
+hart		: 0
+isa		: rv32imc_zicsr_zve32x_zvl32b_zvl64b_zvl128b_zvl256b_zvl512b
+mmu		: sv32)");
+  // Kernels without hwprobe predate user space vector support, vlenb must not
+  // be read.
+  cpu().SetVlenb(64);
+  const auto info = GetRiscvVectorInfo();
+  EXPECT_EQ(info.vlen, 0);
+  EXPECT_EQ(info.elen, 32);
+  EXPECT_EQ(info.zvl, 512);
+}
+
+TEST_F(CpuinfoRiscvTest, NoVectorLengthWhenDisabledByOs) {
+  ResetHwcaps();
+  GetEmptyFilesystem();
+  cpu().SetKey(RISCV_HWPROBE_KEY_BASE_BEHAVIOR,
+               RISCV_HWPROBE_BASE_BEHAVIOR_IMA);
+  cpu().SetKey(RISCV_HWPROBE_KEY_IMA_EXT_0, RISCV_HWPROBE_IMA_V);
+  SetHardwareCapabilities(RISCV_HWCAP_V, 0);
+  // abi.riscv_v_default_allow=0
+  cpu().SetVectorControl(PR_RISCV_V_VSTATE_CTRL_OFF);
+  cpu().SetVlenb(32);
+  const auto info = GetRiscvVectorInfo();
+  EXPECT_EQ(info.vlen, 0);
+  EXPECT_EQ(info.elen, 64);
+  EXPECT_EQ(info.zvl, 128);
+}
+
+TEST_F(CpuinfoRiscvTest, NoVectorInfoWithoutVector) {
+  ResetHwcaps();
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(
+processor	: 0
+hart		: 0
+isa		: rv64imafdc_zicsr_zifencei_xtheadvector
+mmu		: sv39)");
+  // vlenb must not be read, the value below would otherwise show up.
+  cpu().SetVlenb(16);
+  const auto info = GetRiscvVectorInfo();
+  EXPECT_EQ(info.vlen, 0);
+  EXPECT_EQ(info.elen, 0);
+  EXPECT_EQ(info.zvl, 0);
 }
 
 }  // namespace
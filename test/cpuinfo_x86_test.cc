@@ -24,13 +24,16 @@
 
 #include "filesystem_for_testing.h"
 #include "gtest/gtest.h"
+#include "hwcaps_for_testing.h"
 #include "internal/cpuid_x86.h"
+#include "internal/hwcaps.h"
 
 namespace cpu_features {
 
 class FakeCpu {
  public:
-  Leaf GetCpuidLeaf(uint32_t leaf_id, int ecx) const {
+  Leaf GetCpuidLeaf(uint32_t leaf_id, int ecx) {
+    ++cpuid_calls_;
     const auto itr = cpuid_leaves_.find(std::make_pair(leaf_id, ecx));
     if (itr != cpuid_leaves_.end()) {
       return itr->second;
@@ -48,6 +51,66 @@ class FakeCpu {
     xcr0_eax_ = os_backups_extended_registers ? -1 : 0;
   }
 
+  void SetXCR0Eax(uint32_t xcr0_eax) { xcr0_eax_ = xcr0_eax; }
+
+  int GetCpuidCalls() const { return cpuid_calls_; }
+
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+  long LinuxArchPrctl(int option, unsigned long arg) {
+    switch (option) {
+      case 0x1011:  // ARCH_GET_CPUID
+        return cpuid_faulting_ ? 0 : 1;
+      case 0x1022:  // ARCH_GET_XCOMP_PERM
+        *reinterpret_cast<uint64_t*>(arg) = xcomp_perm_;
+        return 0;
+      case 0x1023:  // ARCH_REQ_XCOMP_PERM
+        if (!grants_xcomp_perm_) return -1;
+        xcomp_perm_ |= uint64_t{1} << arg;
+        return 0;
+      case 0x4001:  // ARCH_GET_UNTAG_MASK
+        *reinterpret_cast<uint64_t*>(arg) = untag_mask_;
+        return 0;
+      case 0x4002:  // ARCH_ENABLE_TAGGED_ADDR
+        // Linux only implements LAM_U57 which ignores bits 62:57.
+        if (arg == 0 || arg > max_tag_bits_) return -1;
+        untag_mask_ = ~(((uint64_t{1} << max_tag_bits_) - 1) << 57);
+        return 0;
+      case 0x4003:  // ARCH_GET_MAX_TAG_BITS
+        *reinterpret_cast<unsigned long*>(arg) = max_tag_bits_;
+        return 0;
+    }
+    return -1;
+  }
+
+  void SetCpuidFaulting(bool cpuid_faulting) {
+    cpuid_faulting_ = cpuid_faulting;
+  }
+
+  void SetMaxTagBits(unsigned long max_tag_bits) {
+    max_tag_bits_ = max_tag_bits;
+  }
+
+  int LinuxPkeyAlloc(unsigned int access_rights) {
+    pkey_access_rights_ = access_rights;
+    for (int pkey = 1; pkey < num_pkeys_; ++pkey) {
+      if (allocated_pkeys_.insert(pkey).second) return pkey;
+    }
+    return -1;
+  }
+
+  int LinuxPkeyFree(int pkey) { return allocated_pkeys_.erase(pkey) ? 0 : -1; }
+
+  void SetNumPkeys(int num_pkeys) { num_pkeys_ = num_pkeys; }
+
+  unsigned int GetPkeyAccessRights() const { return pkey_access_rights_; }
+
+  size_t GetNumAllocatedPkeys() const { return allocated_pkeys_.size(); }
+
+  void SetGrantsXCompPerm(bool grants_xcomp_perm) {
+    grants_xcomp_perm_ = grants_xcomp_perm;
+  }
+#endif  // defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+
 #if defined(CPU_FEATURES_OS_MACOS)
   bool GetDarwinSysCtlByName(std::string name) const {
     return darwin_sysctlbyname_.count(name);
@@ -70,12 +133,23 @@ class FakeCpu {
 
  private:
   std::map<std::pair<uint32_t, int>, Leaf> cpuid_leaves_;
+  int cpuid_calls_ = 0;
 #if defined(CPU_FEATURES_OS_MACOS)
   std::set<std::string> darwin_sysctlbyname_;
 #endif  // CPU_FEATURES_OS_MACOS
 #if defined(CPU_FEATURES_OS_WINDOWS)
   std::set<DWORD> windows_isprocessorfeaturepresent_;
 #endif  // CPU_FEATURES_OS_WINDOWS
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+  bool cpuid_faulting_ = false;
+  uint64_t xcomp_perm_ = 0;
+  bool grants_xcomp_perm_ = true;
+  uint64_t untag_mask_ = ~uint64_t{0};
+  unsigned long max_tag_bits_ = 0;
+  int num_pkeys_ = 0;
+  unsigned int pkey_access_rights_ = 0;
+  std::set<int> allocated_pkeys_;
+#endif  // defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
   uint32_t xcr0_eax_;
 };
 
@@ -92,6 +166,18 @@ extern "C" Leaf GetCpuidLeaf(uint32_t leaf_id, int ecx) {
 
 extern "C" uint32_t GetXCR0Eax(void) { return cpu().GetXCR0Eax(); }
 
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+extern "C" long LinuxArchPrctl(int option, unsigned long arg) {
+  return cpu().LinuxArchPrctl(option, arg);
+}
+
+extern "C" int LinuxPkeyAlloc(unsigned int access_rights) {
+  return cpu().LinuxPkeyAlloc(access_rights);
+}
+
+extern "C" int LinuxPkeyFree(int pkey) { return cpu().LinuxPkeyFree(pkey); }
+#endif  // defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+
 #if defined(CPU_FEATURES_OS_MACOS)
 extern "C" bool GetDarwinSysCtlByName(const char* name) {
   return cpu().GetDarwinSysCtlByName(name);
@@ -111,6 +197,7 @@ class CpuidX86Test : public ::testing::Test {
   void SetUp() override {
     assert(g_fake_cpu_instance == nullptr);
     g_fake_cpu_instance = new FakeCpu();
+    ResetX86CpuidCacheForTesting();
   }
   void TearDown() override {
     delete g_fake_cpu_instance;
@@ -1002,6 +1089,7 @@ TEST_F(CpuidX86Test, INTEL_ALDER_LAKE_AVX_VNNI) {
   EXPECT_EQ(info.family, 0x06);
   EXPECT_EQ(info.model, 0x9A);
   EXPECT_TRUE(info.features.avx_vnni);
+  EXPECT_TRUE(info.features.hreset);
   EXPECT_EQ(GetX86Microarchitecture(&info), X86Microarchitecture::INTEL_ADL);
 }
 
@@ -1782,6 +1870,1234 @@ TEST_F(CpuidX86Test, WIN_INTEL_WESTMERE_EX) {
 }
 #endif  // CPU_FEATURES_OS_WINDOWS
 
+// http://users.atw.hu/instlatx64/GenuineIntel/GenuineIntel00806F8_SapphireRapids_CPUID.txt
+TEST_F(CpuidX86Test, INTEL_SAPPHIRE_RAPIDS_XSAVE) {
+  // x87, SSE, AVX, AVX-512, PKRU and AMX.
+  cpu().SetXCR0Eax(0x000602E7);
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x0000001F, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x0000000D, 0}, Leaf{0x000602E7, 0x00002B00, 0x00002B00, 0x00000000}},
+      {{0x0000000D, 1}, Leaf{0x0000001F, 0x00002C10, 0x00019900, 0x00000000}},
+      {{0x0000000D, 2}, Leaf{0x00000100, 0x00000240, 0x00000000, 0x00000000}},
+      {{0x0000000D, 5}, Leaf{0x00000040, 0x00000440, 0x00000000, 0x00000000}},
+      {{0x0000000D, 6}, Leaf{0x00000200, 0x00000480, 0x00000000, 0x00000000}},
+      {{0x0000000D, 7}, Leaf{0x00000400, 0x00000680, 0x00000000, 0x00000000}},
+      {{0x0000000D, 8}, Leaf{0x00000080, 0x00000000, 0x00000001, 0x00000000}},
+      {{0x0000000D, 9}, Leaf{0x00000008, 0x00000A80, 0x00000000, 0x00000000}},
+      {{0x0000000D, 11}, Leaf{0x00000010, 0x00000000, 0x00000001, 0x00000000}},
+      {{0x0000000D, 12}, Leaf{0x00000018, 0x00000000, 0x00000001, 0x00000000}},
+      {{0x0000000D, 15}, Leaf{0x00000328, 0x00000000, 0x00000001, 0x00000000}},
+      {{0x0000000D, 16}, Leaf{0x00000008, 0x00000000, 0x00000001, 0x00000000}},
+      {{0x0000000D, 17}, Leaf{0x00000040, 0x00000AC0, 0x00000002, 0x00000000}},
+      {{0x0000000D, 18}, Leaf{0x00002000, 0x00000B00, 0x00000006, 0x00000000}},
+  });
+  const auto info = GetX86XSaveInfo();
+
+  EXPECT_TRUE(info.xsaveopt);
+  EXPECT_TRUE(info.xsavec);
+  EXPECT_TRUE(info.xgetbv_ecx1);
+  EXPECT_TRUE(info.xsaves);
+  EXPECT_TRUE(info.xfd);
+  EXPECT_EQ(info.user_components, 0x000602E7);
+  EXPECT_EQ(info.supervisor_components, 0x00019900);
+  EXPECT_EQ(info.enabled_components, 0x000602E7);
+  EXPECT_EQ(info.enabled_size, 11008);
+  EXPECT_EQ(info.max_size, 11008);
+  EXPECT_EQ(info.enabled_compacted_size, 11280);
+
+  EXPECT_EQ(info.components[0].size, 160);
+  EXPECT_EQ(info.components[1].offset, 160);
+  EXPECT_EQ(info.components[2].size, 256);
+  EXPECT_EQ(info.components[2].offset, 576);
+  EXPECT_EQ(info.components[3].size, 0);
+  EXPECT_EQ(info.components[7].size, 1024);
+  EXPECT_EQ(info.components[7].offset, 1664);
+  EXPECT_TRUE(info.components[8].supervisor);
+  EXPECT_EQ(info.components[8].offset, 0);
+  EXPECT_FALSE(info.components[17].xfd);
+  EXPECT_TRUE(info.components[17].aligned);
+  EXPECT_EQ(info.components[18].size, 8192);
+  EXPECT_EQ(info.components[18].offset, 2816);
+  EXPECT_TRUE(info.components[18].aligned);
+  EXPECT_TRUE(info.components[18].xfd);
+
+  // x87, SSE and AVX.
+  EXPECT_EQ(GetX86XSaveCompactedSize(&info, 0x7), 832);
+  // Without AMX.
+  EXPECT_EQ(GetX86XSaveCompactedSize(&info, 0x2E7), 2440);
+  // AMX components are 64-byte aligned.
+  EXPECT_EQ(GetX86XSaveCompactedSize(&info, 0x602E7), 10752);
+  // MPX is not supported.
+  EXPECT_EQ(GetX86XSaveCompactedSize(&info, 0x1F), 0);
+}
+
+TEST_F(CpuidX86Test, XSaveNotSupported) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x0000000B, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000206F2, 0x00400800, 0x02BEE3FF, 0xBFEBFBFF}},
+  });
+  const auto info = GetX86XSaveInfo();
+  EXPECT_FALSE(info.xsaveopt);
+  EXPECT_EQ(info.user_components, 0);
+  EXPECT_EQ(info.enabled_size, 0);
+  EXPECT_EQ(info.components[0].size, 0);
+}
+
+TEST_F(CpuidX86Test, INTEL_SAPPHIRE_RAPIDS_AMX) {
+  cpu().SetXCR0Eax(0x000602E7);
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x0000001F, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000002, 0xF3BFBFFB, 0x1B415FFE, 0xFFDD4432}},
+      {{0x0000001D, 0}, Leaf{0x00000001, 0x00000000, 0x00000000, 0x00000000}},
+      {{0x0000001D, 1}, Leaf{0x04002000, 0x00080040, 0x00000010, 0x00000000}},
+      {{0x0000001E, 0}, Leaf{0x00000000, 0x00004010, 0x00000000, 0x00000000}},
+  });
+  const auto info = GetX86AmxInfo();
+  EXPECT_EQ(info.max_palette, 1);
+  EXPECT_EQ(info.palettes[1].total_tile_bytes, 8192);
+  EXPECT_EQ(info.palettes[1].bytes_per_tile, 1024);
+  EXPECT_EQ(info.palettes[1].bytes_per_row, 64);
+  EXPECT_EQ(info.palettes[1].max_names, 8);
+  EXPECT_EQ(info.palettes[1].max_rows, 16);
+  EXPECT_EQ(info.tmul_max_k, 16);
+  EXPECT_EQ(info.tmul_max_n, 64);
+
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+  EXPECT_EQ(GetX86AmxPermission(), X86_AMX_PERMISSION_DENIED);
+  EXPECT_EQ(RequestX86AmxPermission(), X86_AMX_PERMISSION_GRANTED);
+  EXPECT_EQ(GetX86AmxPermission(), X86_AMX_PERMISSION_GRANTED);
+#else
+  EXPECT_EQ(GetX86AmxPermission(), X86_AMX_PERMISSION_GRANTED);
+#endif
+}
+
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+TEST_F(CpuidX86Test, AmxPermissionRefused) {
+  cpu().SetGrantsXCompPerm(false);
+  cpu().SetXCR0Eax(0x000602E7);
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x0000001F, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000002, 0xF3BFBFFB, 0x1B415FFE, 0xFFDD4432}},
+  });
+  EXPECT_EQ(RequestX86AmxPermission(), X86_AMX_PERMISSION_DENIED);
+}
+#endif  // defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+
+TEST_F(CpuidX86Test, AmxTileDataNotEnabledByOs) {
+  // XTILECFG and XTILEDATA are missing from XCR0.
+  cpu().SetXCR0Eax(0x000002E7);
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x0000001F, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000002, 0xF3BFBFFB, 0x1B415FFE, 0xFFDD4432}},
+  });
+  EXPECT_EQ(GetX86AmxPermission(), X86_AMX_PERMISSION_UNSUPPORTED);
+  EXPECT_EQ(RequestX86AmxPermission(), X86_AMX_PERMISSION_UNSUPPORTED);
+}
+
+// Granite Rapids reports AVX10.1 with 512-bit vectors.
+TEST_F(CpuidX86Test, INTEL_GRANITE_RAPIDS_AVX10) {
+  cpu().SetOsBackupsExtendedRegisters(true);
+#if defined(CPU_FEATURES_OS_MACOS)
+  cpu().SetDarwinSysCtlByName("hw.optional.avx512f");
+#endif
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000024, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000A06D1, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000002, 0xF3BFBFFB, 0x1B415FFE, 0xFFDD4432}},
+      {{0x00000007, 1}, Leaf{0x00201C30, 0x00000000, 0x00000000, 0x00080000}},
+      {{0x00000024, 0}, Leaf{0x00000000, 0x00070001, 0x00000000, 0x00000000}},
+  });
+  const auto info = GetX86Info();
+  EXPECT_TRUE(info.features.avx10);
+  EXPECT_TRUE(info.features.avx10_256);
+  EXPECT_TRUE(info.features.avx10_512);
+  EXPECT_EQ(info.avx10_version, 1);
+  EXPECT_EQ(info.avx10_max_vl, 512);
+}
+
+TEST_F(CpuidX86Test, AVX10_256) {
+  cpu().SetOsBackupsExtendedRegisters(true);
+#if defined(CPU_FEATURES_OS_MACOS)
+  cpu().SetDarwinSysCtlByName("hw.optional.avx512f");
+#endif
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000024, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000A06D1, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 1}, Leaf{0x00000000, 0x00000000, 0x00000000, 0x00080000}},
+      {{0x00000024, 0}, Leaf{0x00000000, 0x00030002, 0x00000000, 0x00000000}},
+  });
+  const auto info = GetX86Info();
+  EXPECT_TRUE(info.features.avx10);
+  EXPECT_TRUE(info.features.avx10_256);
+  EXPECT_FALSE(info.features.avx10_512);
+  EXPECT_EQ(info.avx10_version, 2);
+  EXPECT_EQ(info.avx10_max_vl, 256);
+}
+
+TEST_F(CpuidX86Test, AVX10_NoOsSupport) {
+  // The opmask and zmm states are not enabled in XCR0.
+  cpu().SetXCR0Eax(0x00000007);
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000024, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000A06D1, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 1}, Leaf{0x00000000, 0x00000000, 0x00000000, 0x00080000}},
+      {{0x00000024, 0}, Leaf{0x00000000, 0x00070001, 0x00000000, 0x00000000}},
+  });
+  const auto info = GetX86Info();
+  EXPECT_FALSE(info.features.avx10);
+  EXPECT_FALSE(info.features.avx10_512);
+  EXPECT_EQ(info.avx10_version, 0);
+  EXPECT_EQ(info.avx10_max_vl, 0);
+}
+
+TEST_F(CpuidX86Test, APX) {
+  // x87, SSE, AVX, AVX-512 and APX.
+  cpu().SetXCR0Eax(0x000800E7);
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000024, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000A06D1, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 1}, Leaf{0x00000000, 0x00000000, 0x00000000, 0x00200000}},
+  });
+  EXPECT_TRUE(GetX86Info().features.apx_f);
+}
+
+TEST_F(CpuidX86Test, APX_NoOsSupport) {
+  // The extended GPR state (XCR0 bit 19) is not enabled.
+  cpu().SetXCR0Eax(0x000600E7);
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000024, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000A06D1, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 1}, Leaf{0x00000000, 0x00000000, 0x00000000, 0x00200000}},
+  });
+  EXPECT_FALSE(GetX86Info().features.apx_f);
+}
+
+// https://github.com/InstLatx64/InstLatx64/blob/master/GenuineIntel/GenuineIntel00806F8_SapphireRapids_CPUID.txt
+TEST_F(CpuidX86Test, INTEL_SAPPHIRE_RAPIDS_WAITPKG) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x0000001F, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000002, 0xF3BFBFFB, 0x1B415FFE, 0xFFDD4432}},
+      {{0x00000007, 1}, Leaf{0x00001C30, 0x00000000, 0x00000000, 0x00000000}},
+  });
+  const auto features = GetX86Info().features;
+  EXPECT_TRUE(features.waitpkg);
+  EXPECT_TRUE(features.serialize);
+  EXPECT_TRUE(features.uintr);
+  EXPECT_FALSE(features.hreset);
+  EXPECT_FALSE(features.monitorx);
+
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/sys/devices/system/cpu/umwait_control/max_time", "100000\n");
+  fs.CreateFile("/sys/devices/system/cpu/umwait_control/enable_c02", "1\n");
+  const auto umwait = GetX86UmwaitControl();
+  EXPECT_EQ(umwait.max_time, 100000);
+  EXPECT_EQ(umwait.c02_enabled, 1);
+#else
+  const auto umwait = GetX86UmwaitControl();
+  EXPECT_EQ(umwait.max_time, -1);
+  EXPECT_EQ(umwait.c02_enabled, -1);
+#endif
+}
+
+TEST_F(CpuidX86Test, UmwaitControlWithoutWaitpkg) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000016, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000406E3, 0x00100800, 0x7FFAFBBF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000000, 0x029C67AF, 0x00000000, 0x00000000}},
+  });
+  const auto umwait = GetX86UmwaitControl();
+  EXPECT_EQ(umwait.max_time, -1);
+  EXPECT_EQ(umwait.c02_enabled, -1);
+}
+
+// https://github.com/InstLatx64/InstLatx64/blob/master/AuthenticAMD/AuthenticAMD0A10F11_K19_Genoa_CPUID.txt
+TEST_F(CpuidX86Test, AMD_GENOA_MONITORX) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000010, 0x68747541, 0x444D4163, 0x69746E65}},
+      {{0x00000001, 0}, Leaf{0x00A10F11, 0x00800800, 0xFEDA3203, 0x178BFBFF}},
+      {{0x80000000, 0}, Leaf{0x80000028, 0x68747541, 0x444D4163, 0x69746E65}},
+      {{0x80000001, 0}, Leaf{0x00A10F11, 0x40000000, 0x75C237FF, 0x2FD3FBFF}},
+  });
+  const auto features = GetX86Info().features;
+  EXPECT_TRUE(features.monitorx);
+  EXPECT_FALSE(features.waitpkg);
+}
+
+TEST_F(CpuidX86Test, INTEL_GRANITE_RAPIDS_MEMORY_INSTRUCTIONS) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000A06D1, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000002, 0xF3BFBFFB, 0x1B415FFE, 0xFFDD4432}},
+      {{0x00000007, 1}, Leaf{0x00201C30, 0x00000000, 0x00000000, 0x00004000}},
+      {{0x80000000, 0}, Leaf{0x80000008, 0x00000000, 0x00000000, 0x00000000}},
+      {{0x80000001, 0}, Leaf{0x00000000, 0x00000000, 0x00000121, 0x2C100800}},
+      {{0x80000008, 0}, Leaf{0x00003934, 0x00000200, 0x00000000, 0x00000000}},
+  });
+  const auto features = GetX86Info().features;
+  EXPECT_TRUE(features.cldemote);
+  EXPECT_TRUE(features.prefetchw);
+  EXPECT_TRUE(features.prefetchi);
+  EXPECT_TRUE(features.wbnoinvd);
+  EXPECT_TRUE(features.fs_rep_mov);
+  EXPECT_TRUE(features.fs_rep_stosb);
+  EXPECT_TRUE(features.fs_rep_cmpsb_scasb);
+  // CLZERO is AMD only.
+  EXPECT_FALSE(features.clzero);
+}
+
+TEST_F(CpuidX86Test, AMD_GENOA_MEMORY_INSTRUCTIONS) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000010, 0x68747541, 0x444D4163, 0x69746E65}},
+      {{0x00000001, 0}, Leaf{0x00A10F11, 0x00800800, 0xFEDA3203, 0x178BFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000001, 0xF1BF97A9, 0x00405FCE, 0x10000010}},
+      {{0x80000000, 0}, Leaf{0x80000028, 0x68747541, 0x444D4163, 0x69746E65}},
+      {{0x80000001, 0}, Leaf{0x00A10F11, 0x40000000, 0x75C237FF, 0x2FD3FBFF}},
+      {{0x80000008, 0}, Leaf{0x00003034, 0x791EF257, 0x0000707F, 0x00010007}},
+  });
+  const auto features = GetX86Info().features;
+  EXPECT_TRUE(features.prefetchw);
+  EXPECT_TRUE(features.clzero);
+  EXPECT_TRUE(features.wbnoinvd);
+  EXPECT_FALSE(features.cldemote);
+  EXPECT_FALSE(features.prefetchi);
+}
+
+// Sierra Forest has no AVX-512, the VEX encoded ML extensions only need the
+// ymm state.
+TEST_F(CpuidX86Test, INTEL_SIERRA_FOREST_AVX_ML) {
+  // x87, SSE and AVX.
+  cpu().SetXCR0Eax(0x00000007);
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000023, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000A06F3, 0x00800800, 0x7FFAFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000001, 0x239C27EB, 0x994007AC, 0xFC184410}},
+      {{0x00000007, 1}, Leaf{0x00C00030, 0x00000000, 0x00000000, 0x00000430}},
+  });
+  const auto features = GetX86Info().features;
+  EXPECT_TRUE(features.avx_vnni);
+  EXPECT_TRUE(features.avx_vnni_int8);
+  EXPECT_TRUE(features.avx_vnni_int16);
+  EXPECT_TRUE(features.avx_ifma);
+  EXPECT_TRUE(features.avx_ne_convert);
+  EXPECT_FALSE(features.amx_complex);
+}
+
+TEST_F(CpuidX86Test, AMX_COMPLEX_FP8) {
+  // x87, SSE, AVX, AVX-512, PKRU and AMX.
+  cpu().SetXCR0Eax(0x000602E7);
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000024, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000A06D1, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000002, 0xF3BFBFFB, 0x1B415FFE, 0xFFDD4432}},
+      {{0x00000007, 1}, Leaf{0x00201C30, 0x00000000, 0x00000000, 0x00000100}},
+      {{0x0000001E, 1}, Leaf{0x0000001F, 0x00000000, 0x00000000, 0x00000000}},
+  });
+  auto features = GetX86Info().features;
+  EXPECT_TRUE(features.amx_tile);
+  EXPECT_TRUE(features.amx_complex);
+  EXPECT_TRUE(features.amx_fp8);
+
+  // Tile state is not enabled by the OS.
+  cpu().SetXCR0Eax(0x000002E7);
+  features = GetX86Info().features;
+  EXPECT_FALSE(features.amx_tile);
+  EXPECT_FALSE(features.amx_complex);
+  EXPECT_FALSE(features.amx_fp8);
+}
+
+TEST_F(CpuidX86Test, INTEL_ARROW_LAKE_CRYPTO) {
+  // x87, SSE and AVX.
+  cpu().SetXCR0Eax(0x00000007);
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000023, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000C06C2, 0x00800800, 0x7FFAFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000001, 0x239C27EB, 0x19C007AC, 0xFC184410}},
+      {{0x00000007, 1}, Leaf{0x00C00037, 0x00000000, 0x00000000, 0x00000430}},
+      {{0x00000019, 0}, Leaf{0x00000001, 0x00000015, 0x00000003, 0x00000000}},
+  });
+  auto features = GetX86Info().features;
+  EXPECT_TRUE(features.sha);
+  EXPECT_TRUE(features.sha512);
+  EXPECT_TRUE(features.sm3);
+  EXPECT_TRUE(features.sm4);
+  EXPECT_TRUE(features.kl);
+  EXPECT_TRUE(features.aeskle);
+  EXPECT_TRUE(features.wide_kl);
+
+  const auto crypto = GetX86CryptoFeatures(&features);
+  EXPECT_TRUE(crypto.aes);
+  EXPECT_TRUE(crypto.clmul);
+  EXPECT_TRUE(crypto.sha1);
+  EXPECT_TRUE(crypto.sha256);
+  EXPECT_TRUE(crypto.sha512);
+  EXPECT_FALSE(crypto.sha3);
+  EXPECT_TRUE(crypto.sm3);
+  EXPECT_TRUE(crypto.sm4);
+  EXPECT_TRUE(crypto.aes_wrapped_key);
+
+  // AVX state is not enabled by the OS.
+  cpu().SetXCR0Eax(0x00000003);
+  features = GetX86Info().features;
+  EXPECT_FALSE(features.sha512);
+  EXPECT_FALSE(features.sm3);
+  EXPECT_FALSE(features.sm4);
+  EXPECT_TRUE(features.aeskle);
+}
+
+TEST_F(CpuidX86Test, INTEL_SAPPHIRE_RAPIDS_PROFILING) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000002, 0xF3BFBFFB, 0x1B415FFE, 0xFFDD4432}},
+      {{0x0000000A, 0}, Leaf{0x08300805, 0x00000000, 0x0000000F, 0x00008604}},
+      {{0x00000014, 0}, Leaf{0x00000001, 0x0000005F, 0x80000007, 0x00000000}},
+      {{0x00000014, 1}, Leaf{0x02490002, 0x003F003F, 0x00000000, 0x00000000}},
+      {{0x0000001C, 0}, Leaf{0x4000000F, 0x00000007, 0x00000007, 0x00000000}},
+  });
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/sys/bus/event_source/devices/cpu/type", "4\n");
+  fs.CreateFile("/sys/bus/event_source/devices/intel_pt/type", "8\n");
+#endif
+  const auto info = GetX86ProfilingInfo();
+  EXPECT_EQ(info.pmu_version, 5);
+  EXPECT_EQ(info.gp_counters, 8);
+  EXPECT_EQ(info.gp_counter_width, 48);
+  EXPECT_EQ(info.fixed_counters, 4);
+  EXPECT_EQ(info.fixed_counter_width, 48);
+  EXPECT_TRUE(info.pdcm);
+  EXPECT_TRUE(info.ds);
+  EXPECT_TRUE(info.arch_lbr);
+  EXPECT_EQ(info.lbr_depth, 32);
+  EXPECT_TRUE(info.intel_pt);
+  EXPECT_TRUE(info.pt_cr3_filtering);
+  EXPECT_TRUE(info.pt_cycle_accurate);
+  EXPECT_TRUE(info.pt_ip_filtering);
+  EXPECT_TRUE(info.pt_mtc);
+  EXPECT_TRUE(info.pt_ptwrite);
+  EXPECT_FALSE(info.pt_power_event_trace);
+  EXPECT_TRUE(info.pt_topa);
+  EXPECT_TRUE(info.pt_single_range_output);
+  EXPECT_EQ(info.pt_address_ranges, 2);
+  EXPECT_FALSE(info.ibs);
+  EXPECT_FALSE(info.perfmon_v2);
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+  EXPECT_EQ(info.perf_cpu, 1);
+  EXPECT_EQ(info.perf_intel_pt, 1);
+  EXPECT_EQ(info.perf_ibs_op, 0);
+#else
+  EXPECT_EQ(info.perf_cpu, -1);
+  EXPECT_EQ(info.perf_intel_pt, -1);
+  EXPECT_EQ(info.perf_ibs_op, -1);
+#endif
+}
+
+TEST_F(CpuidX86Test, AMD_GENOA_PROFILING) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000010, 0x68747541, 0x444D4163, 0x69746E65}},
+      {{0x00000001, 0}, Leaf{0x00A10F11, 0x00800800, 0xFEDA3203, 0x178BFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000001, 0xF1BF97A9, 0x00405FCE, 0x10000010}},
+      {{0x80000000, 0}, Leaf{0x80000028, 0x68747541, 0x444D4163, 0x69746E65}},
+      {{0x80000001, 0}, Leaf{0x00A10F11, 0x40000000, 0x75C237FF, 0x2FD3FBFF}},
+      {{0x8000001B, 0}, Leaf{0x00000BFF, 0x00000000, 0x00000000, 0x00000000}},
+      {{0x80000022, 0}, Leaf{0x00000007, 0x00004106, 0x00000000, 0x00000000}},
+  });
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+  // The kernel does not drive IBS fetch sampling.
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/sys/bus/event_source/devices/cpu/type", "4\n");
+  fs.CreateFile("/sys/bus/event_source/devices/ibs_op/type", "11\n");
+#endif
+  const auto info = GetX86ProfilingInfo();
+  EXPECT_EQ(info.pmu_version, 0);
+  EXPECT_EQ(info.gp_counters, 6);
+  EXPECT_EQ(info.gp_counter_width, 48);
+  EXPECT_EQ(info.fixed_counters, 0);
+  EXPECT_FALSE(info.ds);
+  EXPECT_FALSE(info.intel_pt);
+  EXPECT_TRUE(info.perfmon_v2);
+  EXPECT_TRUE(info.amd_lbr_v2);
+  EXPECT_EQ(info.lbr_depth, 16);
+  EXPECT_TRUE(info.ibs);
+  EXPECT_TRUE(info.ibs_fetch_sampling);
+  EXPECT_TRUE(info.ibs_op_sampling);
+  EXPECT_TRUE(info.ibs_branch_target);
+  EXPECT_TRUE(info.ibs_l3_miss_filtering);
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+  EXPECT_EQ(info.perf_cpu, 1);
+  EXPECT_EQ(info.perf_ibs_fetch, 0);
+  EXPECT_EQ(info.perf_ibs_op, 1);
+#endif
+}
+
+TEST_F(CpuidX86Test, INTEL_SAPPHIRE_RAPIDS_RDT) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000002, 0xF3BFBFFB, 0x1B415FFE, 0xFFDD4432}},
+      {{0x0000000F, 0}, Leaf{0x00000000, 0x000000EF, 0x00000000, 0x00000002}},
+      {{0x0000000F, 1}, Leaf{0x00000114, 0x0001C000, 0x000000EF, 0x00000007}},
+      {{0x00000010, 0}, Leaf{0x00000000, 0x0000000A, 0x00000000, 0x00000000}},
+      {{0x00000010, 1}, Leaf{0x0000000E, 0x0000C000, 0x00000004, 0x0000000F}},
+      {{0x00000010, 3}, Leaf{0x00000059, 0x00000000, 0x00000004, 0x00000007}},
+  });
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+  // resctrl mounted with -o cdp.
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/sys/fs/resctrl/info/L3CODE/num_closids", "8\n");
+  fs.CreateFile("/sys/fs/resctrl/info/L3DATA/num_closids", "8\n");
+  fs.CreateFile("/sys/fs/resctrl/info/MB/num_closids", "8\n");
+  fs.CreateFile("/sys/fs/resctrl/info/MB/bandwidth_gran", "10\n");
+  fs.CreateFile("/sys/fs/resctrl/info/MB/min_bandwidth", "10\n");
+  fs.CreateFile("/sys/fs/resctrl/info/L3_MON/num_rmids", "240\n");
+#endif
+  const auto info = GetX86RdtInfo();
+  EXPECT_TRUE(info.cmt);
+  EXPECT_TRUE(info.mbm_total);
+  EXPECT_TRUE(info.mbm_local);
+  EXPECT_EQ(info.mon_rmids, 240);
+  EXPECT_EQ(info.mon_upscaling_factor, 0x1C000);
+  EXPECT_EQ(info.mbm_counter_width, 44);
+  EXPECT_TRUE(info.l3_cat);
+  EXPECT_TRUE(info.l3_cdp);
+  EXPECT_EQ(info.l3_cat_classes, 16);
+  EXPECT_EQ(info.l3_cbm_length, 15);
+  EXPECT_FALSE(info.l2_cat);
+  EXPECT_EQ(info.l2_cat_classes, 0);
+  EXPECT_TRUE(info.mba);
+  EXPECT_TRUE(info.mba_linear);
+  EXPECT_EQ(info.mba_classes, 8);
+  EXPECT_EQ(info.mba_max_value, 90);
+  EXPECT_EQ(info.mba_granularity, 10);
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+  EXPECT_EQ(info.resctrl_l3_classes, 8);
+  EXPECT_EQ(info.resctrl_l2_classes, -1);
+  EXPECT_EQ(info.resctrl_mba_classes, 8);
+  EXPECT_EQ(info.resctrl_mon_rmids, 240);
+  EXPECT_EQ(info.resctrl_mba_granularity, 10);
+  EXPECT_EQ(info.resctrl_mba_min_bandwidth, 10);
+#else
+  EXPECT_EQ(info.resctrl_l3_classes, -1);
+  EXPECT_EQ(info.resctrl_mon_rmids, -1);
+  EXPECT_EQ(info.resctrl_mba_granularity, -1);
+#endif
+}
+
+TEST_F(CpuidX86Test, AMD_GENOA_RDT) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000010, 0x68747541, 0x444D4163, 0x69746E65}},
+      {{0x00000001, 0}, Leaf{0x00A10F11, 0x00800800, 0xFEDA3203, 0x178BFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000001, 0xF1BF97A9, 0x00405FCE, 0x10000010}},
+      {{0x0000000F, 0}, Leaf{0x00000000, 0x000000FF, 0x00000000, 0x00000002}},
+      {{0x0000000F, 1}, Leaf{0x00000000, 0x00000040, 0x000000FF, 0x00000007}},
+      {{0x00000010, 0}, Leaf{0x00000000, 0x00000002, 0x00000000, 0x00000000}},
+      {{0x00000010, 1}, Leaf{0x0000000F, 0x00000000, 0x00000000, 0x0000000F}},
+      {{0x80000000, 0}, Leaf{0x80000028, 0x68747541, 0x444D4163, 0x69746E65}},
+      {{0x80000001, 0}, Leaf{0x00A10F11, 0x40000000, 0x75C237FF, 0x2FD3FBFF}},
+      {{0x80000020, 0}, Leaf{0x00000000, 0x0000001E, 0x00000000, 0x00000000}},
+      {{0x80000020, 1}, Leaf{0x0000000B, 0x00000000, 0x00000000, 0x0000000F}},
+  });
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+  // resctrl is not mounted.
+  GetEmptyFilesystem();
+#endif
+  const auto info = GetX86RdtInfo();
+  EXPECT_TRUE(info.cmt);
+  EXPECT_EQ(info.mon_rmids, 256);
+  EXPECT_EQ(info.mbm_counter_width, 24);
+  EXPECT_TRUE(info.l3_cat);
+  EXPECT_FALSE(info.l3_cdp);
+  EXPECT_EQ(info.l3_cat_classes, 16);
+  EXPECT_EQ(info.l3_cbm_length, 16);
+  EXPECT_TRUE(info.mba);
+  EXPECT_FALSE(info.mba_linear);
+  EXPECT_EQ(info.mba_classes, 16);
+  EXPECT_EQ(info.mba_max_value, 2048);
+  EXPECT_EQ(info.mba_granularity, 0);
+  EXPECT_EQ(info.resctrl_l3_classes, -1);
+  EXPECT_EQ(info.resctrl_mba_classes, -1);
+  EXPECT_EQ(info.resctrl_mba_granularity, -1);
+}
+
+TEST_F(CpuidX86Test, INTEL_SAPPHIRE_RAPIDS_TLB) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000018, 0}, Leaf{0x00000008, 0x00000000, 0x00000000, 0x00000000}},
+      {{0x00000018, 1}, Leaf{0x00000000, 0x00080007, 0x00000020, 0x00000022}},
+      {{0x00000018, 2}, Leaf{0x00000000, 0x00060001, 0x00000010, 0x00000024}},
+      {{0x00000018, 3}, Leaf{0x00000000, 0x00040006, 0x00000008, 0x00000024}},
+      {{0x00000018, 4}, Leaf{0x00000000, 0x00080008, 0x00000001, 0x00000124}},
+      {{0x00000018, 5}, Leaf{0x00000000, 0x0010000F, 0x00000001, 0x00000125}},
+      {{0x00000018, 6}, Leaf{0x00000000, 0x00080007, 0x00000100, 0x00000043}},
+      {{0x00000018, 7}, Leaf{0x00000000, 0x00080008, 0x00000080, 0x00000043}},
+  });
+  const auto info = GetX86TlbInfo();
+  ASSERT_EQ(info.size, 7);
+  EXPECT_EQ(info.levels[0].level, 1);
+  EXPECT_EQ(info.levels[0].tlb_type, CPU_FEATURE_TLB_INSTRUCTION);
+  EXPECT_TRUE(info.levels[0].page_4k);
+  EXPECT_TRUE(info.levels[0].page_2m);
+  EXPECT_TRUE(info.levels[0].page_4m);
+  EXPECT_FALSE(info.levels[0].page_1g);
+  EXPECT_EQ(info.levels[0].entries, 256);
+  EXPECT_EQ(info.levels[0].ways, 8);
+  EXPECT_EQ(info.levels[1].tlb_type, CPU_FEATURE_TLB_LOAD);
+  EXPECT_TRUE(info.levels[1].page_4k);
+  EXPECT_FALSE(info.levels[1].page_2m);
+  EXPECT_EQ(info.levels[1].entries, 96);
+  EXPECT_EQ(info.levels[1].ways, 6);
+  EXPECT_EQ(info.levels[2].tlb_type, CPU_FEATURE_TLB_LOAD);
+  EXPECT_TRUE(info.levels[2].page_2m);
+  EXPECT_EQ(info.levels[2].entries, 32);
+  EXPECT_EQ(info.levels[3].tlb_type, CPU_FEATURE_TLB_LOAD);
+  EXPECT_TRUE(info.levels[3].page_1g);
+  EXPECT_EQ(info.levels[3].entries, 8);
+  EXPECT_EQ(info.levels[3].ways, 0xFF);
+  EXPECT_EQ(info.levels[4].tlb_type, CPU_FEATURE_TLB_STORE);
+  EXPECT_EQ(info.levels[4].entries, 16);
+  EXPECT_EQ(info.levels[4].ways, 0xFF);
+  EXPECT_EQ(info.levels[5].level, 2);
+  EXPECT_EQ(info.levels[5].tlb_type, CPU_FEATURE_TLB_UNIFIED);
+  EXPECT_EQ(info.levels[5].entries, 2048);
+  EXPECT_EQ(info.levels[5].ways, 8);
+  EXPECT_EQ(info.levels[6].level, 2);
+  EXPECT_TRUE(info.levels[6].page_1g);
+  EXPECT_FALSE(info.levels[6].page_4k);
+  EXPECT_EQ(info.levels[6].entries, 1024);
+}
+
+TEST_F(CpuidX86Test, AMD_GENOA_TLB) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000010, 0x68747541, 0x444D4163, 0x69746E65}},
+      {{0x00000001, 0}, Leaf{0x00A10F11, 0x00800800, 0xFEDA3203, 0x178BFBFF}},
+      {{0x80000000, 0}, Leaf{0x80000028, 0x68747541, 0x444D4163, 0x69746E65}},
+      {{0x80000005, 0}, Leaf{0xFF48FF40, 0xFF48FF40, 0x20080140, 0x20080140}},
+      {{0x80000006, 0}, Leaf{0x6C006200, 0x6C006200, 0x04006140, 0x00009140}},
+      {{0x80000019, 0}, Leaf{0xF048F040, 0x6C000000, 0x00000000, 0x00000000}},
+  });
+  const auto info = GetX86TlbInfo();
+  ASSERT_EQ(info.size, 11);
+  // L1 4 KiB.
+  EXPECT_EQ(info.levels[0].level, 1);
+  EXPECT_EQ(info.levels[0].tlb_type, CPU_FEATURE_TLB_DATA);
+  EXPECT_TRUE(info.levels[0].page_4k);
+  EXPECT_EQ(info.levels[0].entries, 72);
+  EXPECT_EQ(info.levels[0].ways, 0xFF);
+  EXPECT_EQ(info.levels[1].tlb_type, CPU_FEATURE_TLB_INSTRUCTION);
+  EXPECT_EQ(info.levels[1].entries, 64);
+  // L1 2 MiB and 4 MiB.
+  EXPECT_TRUE(info.levels[2].page_2m);
+  EXPECT_TRUE(info.levels[2].page_4m);
+  EXPECT_FALSE(info.levels[2].page_4k);
+  EXPECT_EQ(info.levels[2].entries, 72);
+  // L1 1 GiB.
+  EXPECT_EQ(info.levels[4].level, 1);
+  EXPECT_TRUE(info.levels[4].page_1g);
+  EXPECT_EQ(info.levels[4].entries, 72);
+  EXPECT_EQ(info.levels[4].ways, 255);
+  // L2 4 KiB.
+  EXPECT_EQ(info.levels[6].level, 2);
+  EXPECT_EQ(info.levels[6].tlb_type, CPU_FEATURE_TLB_DATA);
+  EXPECT_TRUE(info.levels[6].page_4k);
+  EXPECT_EQ(info.levels[6].entries, 3072);
+  EXPECT_EQ(info.levels[6].ways, 8);
+  EXPECT_EQ(info.levels[7].tlb_type, CPU_FEATURE_TLB_INSTRUCTION);
+  EXPECT_EQ(info.levels[7].entries, 512);
+  // L2 1 GiB, there is no L2 1 GiB instruction TLB.
+  EXPECT_EQ(info.levels[10].level, 2);
+  EXPECT_EQ(info.levels[10].tlb_type, CPU_FEATURE_TLB_DATA);
+  EXPECT_TRUE(info.levels[10].page_1g);
+  EXPECT_EQ(info.levels[10].entries, 3072);
+}
+
+// Leaf 2 may report up to 15 descriptors, more than CacheInfo holds.
+TEST_F(CpuidX86Test, Leaf2DescriptorsOverflow) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000002, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x00000F27, 0x00010808, 0x00004400, 0xBFEBFBFF}},
+      {{0x00000002, 0}, Leaf{0x665B5001, 0x0C0A0806, 0x2C2E0D0B, 0x7B7C7D7F}},
+  });
+  const auto info = GetX86CacheInfo();
+  EXPECT_EQ(info.size, CPU_FEATURES_MAX_CACHE_LEVEL);
+}
+
+TEST_F(CpuidX86Test, INTEL_SAPPHIRE_RAPIDS_HUGE_PAGES) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x80000000, 0}, Leaf{0x80000008, 0x00000000, 0x00000000, 0x00000000}},
+      {{0x80000001, 0}, Leaf{0x00000000, 0x00000000, 0x00000121, 0x2C100800}},
+  });
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/sys/kernel/mm/transparent_hugepage/enabled",
+                "always [madvise] never\n");
+  fs.CreateFile("/sys/kernel/mm/transparent_hugepage/defrag",
+                "always defer [defer+madvise] madvise never\n");
+  fs.CreateFile("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size",
+                "2097152\n");
+  fs.CreateFile("/sys/kernel/mm/hugepages/hugepages-2048kB/nr_hugepages",
+                "1024\n");
+  fs.CreateFile("/sys/kernel/mm/hugepages/hugepages-2048kB/free_hugepages",
+                "1000\n");
+  fs.CreateFile("/sys/kernel/mm/hugepages/hugepages-1048576kB/nr_hugepages",
+                "4\n");
+  fs.CreateFile("/sys/kernel/mm/hugepages/hugepages-1048576kB/free_hugepages",
+                "4\n");
+  fs.CreateFile("/sys/devices/system/node/online", "0-1\n");
+  fs.CreateFile(
+      "/sys/devices/system/node/node0/hugepages/hugepages-2048kB/nr_hugepages",
+      "512\n");
+  fs.CreateFile(
+      "/sys/devices/system/node/node0/hugepages/hugepages-2048kB/"
+      "free_hugepages",
+      "500\n");
+  fs.CreateFile(
+      "/sys/devices/system/node/node1/hugepages/hugepages-2048kB/nr_hugepages",
+      "512\n");
+  fs.CreateFile(
+      "/sys/devices/system/node/node1/hugepages/hugepages-2048kB/"
+      "free_hugepages",
+      "500\n");
+  const auto info = GetX86HugePageInfo();
+  EXPECT_EQ(info.page_size, 4096);
+  ASSERT_EQ(info.size, 2);
+  EXPECT_EQ(info.sizes[0].size_kb, 2048);
+  EXPECT_EQ(info.sizes[1].size_kb, 1024 * 1024);
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+  EXPECT_EQ(info.thp_enabled, CPU_FEATURE_THP_MADVISE);
+  EXPECT_EQ(info.thp_defrag, CPU_FEATURE_THP_DEFRAG_DEFER_MADVISE);
+  EXPECT_EQ(info.thp_size_kb, 2048);
+  EXPECT_EQ(info.sizes[0].total, 1024);
+  EXPECT_EQ(info.sizes[0].free, 1000);
+  ASSERT_EQ(info.nodes, 2);
+  EXPECT_EQ(info.nodes_truncated, 0);
+  EXPECT_EQ(info.node_ids[0], 0);
+  EXPECT_EQ(info.node_ids[1], 1);
+  EXPECT_EQ(info.sizes[0].node_total[0], 512);
+  EXPECT_EQ(info.sizes[0].node_free[0], 500);
+  EXPECT_EQ(info.sizes[0].node_total[1], 512);
+  EXPECT_EQ(info.sizes[0].node_free[1], 500);
+  EXPECT_EQ(info.sizes[0].node_total[2], -1);
+  EXPECT_EQ(info.sizes[1].total, 4);
+  EXPECT_EQ(info.sizes[1].free, 4);
+  EXPECT_EQ(info.sizes[1].node_total[0], -1);
+#else
+  EXPECT_EQ(info.thp_enabled, CPU_FEATURE_THP_UNKNOWN);
+  EXPECT_EQ(info.sizes[0].total, -1);
+#endif  // defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+}
+
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+TEST_F(CpuidX86Test, HugePagesSparseNumaNodes) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+  });
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/sys/devices/system/node/online", "0,2,4-12\n");
+  fs.CreateFile(
+      "/sys/devices/system/node/node2/hugepages/hugepages-2048kB/nr_hugepages",
+      "16\n");
+  fs.CreateFile(
+      "/sys/devices/system/node/node4/hugepages/hugepages-2048kB/nr_hugepages",
+      "32\n");
+  const auto info = GetX86HugePageInfo();
+  ASSERT_EQ(info.size, 1);
+  ASSERT_EQ(info.nodes, CPU_FEATURES_MAX_NUMA_NODES);
+  EXPECT_EQ(info.nodes_truncated, 1);
+  EXPECT_EQ(info.node_ids[0], 0);
+  EXPECT_EQ(info.node_ids[1], 2);
+  EXPECT_EQ(info.node_ids[2], 4);
+  EXPECT_EQ(info.node_ids[7], 9);
+  EXPECT_EQ(info.sizes[0].node_total[0], -1);
+  EXPECT_EQ(info.sizes[0].node_total[1], 16);
+  EXPECT_EQ(info.sizes[0].node_total[2], 32);
+}
+#endif  // defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+
+// Synthetic: Sapphire Rapids leaves with LAM (leaf 7.1 EAX bit 26) added.
+TEST_F(CpuidX86Test, LA57_LAM_ADDRESS_SPACE) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000002, 0xF3BFBFFB, 0x1B415FFE, 0xFFDD4432}},
+      {{0x00000007, 1}, Leaf{0x04001C30, 0x00000000, 0x00000000, 0x00000000}},
+      {{0x80000000, 0}, Leaf{0x80000008, 0x00000000, 0x00000000, 0x00000000}},
+      {{0x80000008, 0}, Leaf{0x00003934, 0x00000000, 0x00000000, 0x00000000}},
+  });
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+  cpu().SetMaxTagBits(6);
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(processor       : 0
+flags           : fpu vme de pse tsc msr la57 lam
+)");
+#endif  // defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+  auto info = GetX86AddressSpace();
+  EXPECT_EQ(info.physical_address_bits, 52);
+  EXPECT_EQ(info.virtual_address_bits, 57);
+  EXPECT_TRUE(info.la57);
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+  EXPECT_EQ(info.la57_enabled, 1);
+  EXPECT_EQ(info.max_tag_bits, 6);
+  EXPECT_EQ(info.tag_bits, 0);
+  EXPECT_EQ(EnableX86TaggedAddresses(7), -1);
+  EXPECT_EQ(EnableX86TaggedAddresses(6), 0);
+  info = GetX86AddressSpace();
+  EXPECT_EQ(info.tag_bits, 6);
+#else
+  EXPECT_EQ(info.la57_enabled, -1);
+  EXPECT_EQ(info.max_tag_bits, -1);
+  EXPECT_EQ(EnableX86TaggedAddresses(6), -1);
+#endif  // defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+}
+
+TEST_F(CpuidX86Test, AMD_MILAN_ADDRESS_SPACE) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000010, 0x68747541, 0x444D4163, 0x69746E65}},
+      {{0x00000001, 0}, Leaf{0x00A00F11, 0x00800800, 0xFEDA3203, 0x178BFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000001, 0xF1BF97A9, 0x00405FCE, 0x10000010}},
+      {{0x80000000, 0}, Leaf{0x80000028, 0x68747541, 0x444D4163, 0x69746E65}},
+      {{0x80000008, 0}, Leaf{0x00003030, 0x791EF257, 0x0000707F, 0x00010007}},
+  });
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(processor       : 0
+flags           : fpu vme de pse tsc msr
+)");
+  const auto info = GetX86AddressSpace();
+  EXPECT_EQ(info.physical_address_bits, 48);
+  EXPECT_EQ(info.virtual_address_bits, 48);
+  EXPECT_FALSE(info.la57);
+  EXPECT_EQ(info.la57_enabled, 0);
+  EXPECT_EQ(info.max_tag_bits, 0);
+  EXPECT_EQ(info.tag_bits, 0);
+  EXPECT_EQ(EnableX86TaggedAddresses(6), -1);
+}
+
+TEST_F(CpuidX86Test, INTEL_SAPPHIRE_RAPIDS_RDPID_RDTSCP) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000002, 0xF3BFBFFB, 0x1B415FFE, 0xFFDD4432}},
+      {{0x80000000, 0}, Leaf{0x80000008, 0x00000000, 0x00000000, 0x00000000}},
+      {{0x80000001, 0}, Leaf{0x00000000, 0x00000000, 0x00000121, 0x2C100800}},
+  });
+  const auto features = GetX86Info().features;
+  EXPECT_TRUE(features.tsc);
+  EXPECT_TRUE(features.rdtscp);
+  EXPECT_TRUE(features.rdpid);
+}
+
+TEST_F(CpuidX86Test, INTEL_SAPPHIRE_RAPIDS_PKU) {
+  cpu().SetXCR0Eax(0x000602E7);
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000002, 0xF3BFBFFB, 0x1B415FFE, 0xFFDD4432}},
+  });
+  const auto features = GetX86Info().features;
+  EXPECT_TRUE(features.pku);
+  EXPECT_TRUE(features.ospke);
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+  cpu().SetNumPkeys(16);
+  const auto pkeys = GetX86ProtectionKeys();
+  EXPECT_TRUE(pkeys.supported);
+  EXPECT_EQ(pkeys.num_keys, 15);
+  EXPECT_EQ(cpu().GetNumAllocatedPkeys(), 0);
+  // PKEY_DISABLE_ACCESS, the thread keeps no rights on the probed keys.
+  EXPECT_EQ(cpu().GetPkeyAccessRights(), 0x1);
+#else
+  const auto pkeys = GetX86ProtectionKeys();
+  EXPECT_TRUE(pkeys.supported);
+  EXPECT_EQ(pkeys.num_keys, -1);
+#endif  // defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+}
+
+TEST_F(CpuidX86Test, PkuNotEnabledByOs) {
+  // OSPKE and the PKRU state in XCR0 are both clear.
+  cpu().SetXCR0Eax(0x000000E7);
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000002, 0xF3BFBFFB, 0x1B415FEE, 0xFFDD4432}},
+  });
+  const auto features = GetX86Info().features;
+  EXPECT_FALSE(features.pku);
+  EXPECT_FALSE(features.ospke);
+  const auto pkeys = GetX86ProtectionKeys();
+  EXPECT_FALSE(pkeys.supported);
+  EXPECT_EQ(pkeys.num_keys, -1);
+}
+
+TEST_F(CpuidX86Test, INTEL_SAPPHIRE_RAPIDS_RTM_USABLE) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000002, 0xF3BFBFFB, 0x1B415FFE, 0xFFDD4432}},
+  });
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(processor       : 0
+flags           : fpu vme de pse tsc msr hle rtm
+)");
+  fs.CreateFile("/sys/devices/system/cpu/vulnerabilities/tsx_async_abort",
+                "Not affected\n");
+  const auto features = GetX86Info().features;
+  EXPECT_TRUE(features.rtm);
+  EXPECT_FALSE(features.rtm_always_abort);
+  EXPECT_FALSE(features.tsx_force_abort);
+  EXPECT_TRUE(features.rtm_usable);
+  EXPECT_TRUE(GetX86FeaturesEnumValue(&features, X86_RTM_USABLE));
+  EXPECT_TRUE(IsX86RtmUsable());
+}
+
+// Microcode updates for TAA set RTM_ALWAYS_ABORT and keep the rtm bit.
+TEST_F(CpuidX86Test, INTEL_COMET_LAKE_RTM_ALWAYS_ABORT) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000016, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000A0655, 0x00100800, 0x7FFAFBBF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000000, 0x029C6FBF, 0x40000000, 0xBC002E00}},
+  });
+  GetEmptyFilesystem();
+  const auto features = GetX86Info().features;
+  EXPECT_TRUE(features.rtm);
+  EXPECT_TRUE(features.rtm_always_abort);
+  EXPECT_TRUE(features.tsx_force_abort);
+  EXPECT_FALSE(features.rtm_usable);
+  EXPECT_FALSE(IsX86RtmUsable());
+}
+
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+TEST_F(CpuidX86Test, RtmDisabledByTaaMitigation) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000016, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000906ED, 0x00100800, 0x7FFAFBBF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000000, 0x029C6FBF, 0x40000000, 0xBC000400}},
+  });
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/sys/devices/system/cpu/vulnerabilities/tsx_async_abort",
+                "Mitigation: TSX disabled\n");
+  const auto features = GetX86Info().features;
+  EXPECT_TRUE(features.rtm);
+  EXPECT_FALSE(features.rtm_always_abort);
+  EXPECT_TRUE(features.rtm_usable);
+  EXPECT_FALSE(IsX86RtmUsable());
+}
+
+TEST_F(CpuidX86Test, RtmClearedByKernel) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000016, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000906ED, 0x00100800, 0x7FFAFBBF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000000, 0x029C6FBF, 0x40000000, 0xBC000400}},
+  });
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(processor       : 0
+flags           : fpu vme de pse tsc msr hle
+)");
+  const auto features = GetX86Info().features;
+  EXPECT_TRUE(features.rtm);
+  EXPECT_TRUE(features.rtm_usable);
+  EXPECT_FALSE(IsX86RtmUsable());
+}
+#endif  // defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+
+TEST_F(CpuidX86Test, HypervisorKvm) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x0000001F, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0xFFFAF3FF, 0x1F8BFBFF}},
+      {{0x40000000, 0}, Leaf{0x40000001, 0x4B4D564B, 0x564B4D56, 0x0000004D}},
+      {{0x40000001, 0}, Leaf{0x01007AFB, 0x00000000, 0x00000000, 0x00000000}},
+  });
+  EXPECT_TRUE(GetX86Info().features.hypervisor);
+  const auto info = GetX86HypervisorInfo();
+  EXPECT_EQ(info.vendor, X86_HYPERVISOR_KVM);
+  EXPECT_STREQ(info.signature, "KVMKVMKVM");
+  EXPECT_EQ(info.max_leaf, 0x40000001);
+  EXPECT_EQ(info.tsc_khz, 0);
+  EXPECT_TRUE(info.kvm_clocksource);
+  EXPECT_TRUE(info.kvm_async_pf);
+  EXPECT_TRUE(info.kvm_steal_time);
+  EXPECT_TRUE(info.kvm_pv_eoi);
+  EXPECT_TRUE(info.kvm_pv_unhalt);
+  EXPECT_TRUE(info.kvm_pv_tlb_flush);
+  EXPECT_TRUE(info.kvm_pv_send_ipi);
+  EXPECT_TRUE(info.kvm_poll_control);
+  EXPECT_TRUE(info.kvm_pv_sched_yield);
+  EXPECT_FALSE(info.kvm_hint_realtime);
+  EXPECT_FALSE(info.hyperv_synic);
+}
+
+TEST_F(CpuidX86Test, HypervisorHyperv) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x0000001F, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0xFFFAF3FF, 0x1F8BFBFF}},
+      {{0x40000000, 0}, Leaf{0x4000000C, 0x7263694D, 0x666F736F, 0x76482074}},
+      {{0x40000001, 0}, Leaf{0x31237648, 0x00000000, 0x00000000, 0x00000000}},
+      {{0x40000003, 0}, Leaf{0x00002E7F, 0x00000000, 0x00000000, 0x00000000}},
+      {{0x40000004, 0}, Leaf{0x00020E24, 0xFFFFFFFF, 0x00000000, 0x00000000}},
+  });
+  const auto info = GetX86HypervisorInfo();
+  EXPECT_EQ(info.vendor, X86_HYPERVISOR_HYPERV);
+  EXPECT_STREQ(info.signature, "Microsoft Hv");
+  EXPECT_TRUE(info.hyperv_reference_counter);
+  EXPECT_TRUE(info.hyperv_synic);
+  EXPECT_TRUE(info.hyperv_synthetic_timers);
+  EXPECT_TRUE(info.hyperv_apic_msrs);
+  EXPECT_TRUE(info.hyperv_hypercall_msrs);
+  EXPECT_TRUE(info.hyperv_vp_index);
+  EXPECT_TRUE(info.hyperv_reference_tsc);
+  EXPECT_TRUE(info.hyperv_frequency_msrs);
+  EXPECT_TRUE(info.hyperv_remote_tlb_flush);
+  EXPECT_TRUE(info.hyperv_relaxed_timing);
+  EXPECT_TRUE(info.hyperv_ex_processor_masks);
+  EXPECT_EQ(info.hyperv_spinlock_retries, -1);
+  EXPECT_FALSE(info.kvm_pv_unhalt);
+}
+
+// KVM moves its own leaves to 0x40000100 when it emulates Hyper-V.
+TEST_F(CpuidX86Test, HypervisorKvmWithHypervEnlightenments) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x0000001F, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0xFFFAF3FF, 0x1F8BFBFF}},
+      {{0x40000000, 0}, Leaf{0x40000010, 0x7263694D, 0x666F736F, 0x76482074}},
+      {{0x40000001, 0}, Leaf{0x31237648, 0x00000000, 0x00000000, 0x00000000}},
+      {{0x40000003, 0}, Leaf{0x00000272, 0x00000000, 0x00000000, 0x00000000}},
+      {{0x40000004, 0}, Leaf{0x00000024, 0x00000FFF, 0x00000000, 0x00000000}},
+      {{0x40000010, 0}, Leaf{0x0023C346, 0x000F4240, 0x00000000, 0x00000000}},
+      {{0x40000100, 0}, Leaf{0x40000101, 0x4B4D564B, 0x564B4D56, 0x0000004D}},
+      {{0x40000101, 0}, Leaf{0x000000F8, 0x00000000, 0x00000000, 0x00000001}},
+  });
+  const auto info = GetX86HypervisorInfo();
+  EXPECT_EQ(info.vendor, X86_HYPERVISOR_HYPERV);
+  EXPECT_EQ(info.tsc_khz, 2343750);
+  EXPECT_TRUE(info.hyperv_vp_index);
+  EXPECT_FALSE(info.hyperv_ex_processor_masks);
+  EXPECT_EQ(info.hyperv_spinlock_retries, 0xFFF);
+  EXPECT_TRUE(info.kvm_clocksource);
+  EXPECT_TRUE(info.kvm_pv_unhalt);
+  EXPECT_FALSE(info.kvm_pv_tlb_flush);
+  EXPECT_TRUE(info.kvm_hint_realtime);
+}
+
+TEST_F(CpuidX86Test, HypervisorNone) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+      {{0x40000000, 0}, Leaf{0x00000020, 0x00000000, 0x00000000, 0x00000000}},
+  });
+  EXPECT_FALSE(GetX86Info().features.hypervisor);
+  const auto info = GetX86HypervisorInfo();
+  EXPECT_EQ(info.vendor, X86_HYPERVISOR_NONE);
+  EXPECT_STREQ(info.signature, "");
+}
+
+TEST_F(CpuidX86Test, ConfidentialTdxGuest) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000021, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0xFFFAF3FF, 0x1F8BFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000001, 0xF1BF07AB, 0x1B417F5E, 0xBC010410}},
+      {{0x00000021, 0}, Leaf{0x00000000, 0x65746E49, 0x20202020, 0x5844546C}},
+  });
+  const auto info = GetX86ConfidentialInfo();
+  EXPECT_EQ(info.guest, X86_CC_GUEST_TDX);
+  EXPECT_TRUE(info.cpuid_expensive);
+  EXPECT_TRUE(info.tme);
+  EXPECT_FALSE(info.sev);
+}
+
+// https://www.amd.com/content/dam/amd/en/documents/epyc-technical-docs/programmer-references/55901_B1_pub_0_7.zip
+TEST_F(CpuidX86Test, AMD_GENOA_CONFIDENTIAL) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000010, 0x68747541, 0x444D4163, 0x69746E65}},
+      {{0x00000001, 0}, Leaf{0x00A10F11, 0x00800800, 0x7EFA320B, 0x178BFBFF}},
+      {{0x80000000, 0}, Leaf{0x80000028, 0x68747541, 0x444D4163, 0x69746E65}},
+      {{0x8000001F, 0}, Leaf{0x0101FDFF, 0x00000073, 0x000003EF, 0x00000080}},
+  });
+  const auto info = GetX86ConfidentialInfo();
+  EXPECT_EQ(info.guest, X86_CC_GUEST_NONE);
+  EXPECT_FALSE(info.cpuid_expensive);
+  EXPECT_TRUE(info.sme);
+  EXPECT_TRUE(info.sev);
+  EXPECT_TRUE(info.sev_es);
+  EXPECT_TRUE(info.sev_snp);
+  EXPECT_EQ(info.c_bit_position, 51);
+  EXPECT_EQ(info.physical_address_reduction, 1);
+  EXPECT_EQ(info.encrypted_guests, 1007);
+  EXPECT_EQ(info.min_sev_no_es_asid, 128);
+}
+
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+TEST_F(CpuidX86Test, ConfidentialSevSnpGuest) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000010, 0x68747541, 0x444D4163, 0x69746E65}},
+      {{0x00000001, 0}, Leaf{0x00A10F11, 0x00800800, 0xFEDA3203, 0x178BFBFF}},
+      {{0x80000000, 0}, Leaf{0x80000028, 0x68747541, 0x444D4163, 0x69746E65}},
+      {{0x8000001F, 0}, Leaf{0x0000001A, 0x00000073, 0x00000000, 0x00000000}},
+  });
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/sys/class/misc/sev-guest/dev", "10:124\n");
+  const auto info = GetX86ConfidentialInfo();
+  EXPECT_EQ(info.guest, X86_CC_GUEST_SEV_SNP);
+  EXPECT_TRUE(info.cpuid_expensive);
+}
+
+TEST_F(CpuidX86Test, ConfidentialSevEsGuestFromCpuInfo) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000010, 0x68747541, 0x444D4163, 0x69746E65}},
+      {{0x00000001, 0}, Leaf{0x00A10F11, 0x00800800, 0xFEDA3203, 0x178BFBFF}},
+  });
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(processor       : 0
+flags           : fpu vme de pse tsc msr hypervisor sme sev sev_es
+)");
+  EXPECT_EQ(GetX86ConfidentialInfo().guest, X86_CC_GUEST_SEV_ES);
+}
+#endif  // defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+
+#if defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+TEST_F(CpuidX86Test, CpuidFaulting) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+  });
+  EXPECT_FALSE(IsX86CpuidFaulting());
+  cpu().SetCpuidFaulting(true);
+  EXPECT_TRUE(IsX86CpuidFaulting());
+  // Probing faulting does not enable the cache, the caller opts in.
+  EXPECT_FALSE(GetX86ConfidentialInfo().cpuid_expensive);
+  EnableX86CpuidCache();
+  const auto info = GetX86ConfidentialInfo();
+  EXPECT_TRUE(info.cpuid_expensive);
+  EXPECT_EQ(info.guest, X86_CC_GUEST_NONE);
+}
+
+TEST_F(CpuidX86Test, INTEL_SAPPHIRE_RAPIDS_FROM_OS) {
+  // No CPUID leaf is configured, everything comes from the OS.
+  cpu().SetLeaves({});
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(processor       : 0
+vendor_id       : GenuineIntel
+cpu family      : 6
+model           : 143
+model name      : Intel(R) Xeon(R) Platinum 8480+
+stepping        : 8
+microcode       : 0x2b000590
+flags           : fpu vme de pse tsc msr pae mce cx8 apic sep mtrr pge mca cmov pat pse36 clflush dts acpi mmx fxsr sse sse2 ss ht tm pbe syscall nx pdpe1gb rdtscp lm constant_tsc pni pclmulqdq monitor ssse3 fma cx16 pcid sse4_1 sse4_2 x2apic movbe popcnt aes xsave avx f16c rdrand lahf_lm abm 3dnowprefetch fsgsbase bmi1 hle avx2 smep bmi2 erms invpcid cqm rdt_a avx512f avx512dq rdseed adx smap avx512ifma clflushopt clwb avx512cd sha_ni avx512bw avx512vl xsaveopt xsavec xgetbv1 xsaves avx_vnni avx512_bf16 wbnoinvd avx512vbmi umip pku ospke waitpkg avx512_vbmi2 gfni vaes vpclmulqdq avx512_vnni avx512_bitalg tme avx512_vpopcntdq la57 rdpid cldemote movdiri movdir64b enqcmd fsrm md_clear serialize tsxldtrk amx_bf16 avx512_fp16 amx_tile amx_int8 flush_l1d arch_capabilities
+
+processor       : 1
+vendor_id       : GenuineIntel
+)");
+  SetHardwareCapabilities(0xBFEBFBFF, X86_HWCAP2_FSGSBASE);
+  const auto info = GetX86InfoFromOs();
+  ResetHwcaps();
+
+  EXPECT_STREQ(info.vendor, CPU_FEATURES_VENDOR_GENUINE_INTEL);
+  EXPECT_EQ(info.family, 0x06);
+  EXPECT_EQ(info.model, 0x8F);
+  EXPECT_EQ(info.stepping, 0x08);
+  EXPECT_STREQ(info.brand_string, "Intel(R) Xeon(R) Platinum 8480+");
+  EXPECT_EQ(GetX86Microarchitecture(&info), INTEL_SPR);
+
+  const auto& features = info.features;
+  EXPECT_TRUE(features.sse3);
+  EXPECT_TRUE(features.fma3);
+  EXPECT_TRUE(features.lzcnt);
+  EXPECT_TRUE(features.sha);
+  EXPECT_TRUE(features.avx512vbmi2);
+  EXPECT_TRUE(features.amx_tile);
+  EXPECT_TRUE(features.fs_rep_mov);
+  EXPECT_TRUE(features.fsgsbase);
+  EXPECT_TRUE(features.pku);
+  // The kernel hides rtm when TSX is disabled.
+  EXPECT_TRUE(features.hle);
+  EXPECT_FALSE(features.rtm);
+  EXPECT_FALSE(features.rtm_usable);
+}
+
+// avx512_4vbmi2 aliases avx512_4fmaps, both from CPUID and from the OS.
+TEST_F(CpuidX86Test, AVX512_4FMAPS_FROM_OS) {
+  cpu().SetOsBackupsExtendedRegisters(true);
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x0000000D, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x00080650, 0x02FF0800, 0x7FF8F3BF, 0xBFEBFBFF}},
+      {{0x00000007, 0}, Leaf{0x00000000, 0x00010000, 0x00000000, 0x0000000C}},
+  });
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/proc/cpuinfo", R"(processor       : 0
+vendor_id       : GenuineIntel
+cpu family      : 6
+model           : 133
+flags           : fpu vme de pse tsc msr avx avx512f avx512_4vnniw avx512_4fmaps
+)");
+  const auto from_cpuid = GetX86Info().features;
+  const auto from_os = GetX86InfoFromOs().features;
+  EXPECT_TRUE(from_cpuid.avx512_4fmaps);
+  EXPECT_TRUE(from_cpuid.avx512_4vbmi2);
+  EXPECT_TRUE(from_os.avx512_4fmaps);
+  EXPECT_TRUE(from_os.avx512_4vbmi2);
+  EXPECT_TRUE(from_os.avx512_4vnniw);
+}
+
+TEST_F(CpuidX86Test, X86InfoFromOsWithoutProcCpuInfo) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+  });
+  GetEmptyFilesystem();
+  const auto info = GetX86InfoFromOs();
+  EXPECT_STREQ(info.vendor, CPU_FEATURES_VENDOR_GENUINE_INTEL);
+  EXPECT_EQ(info.model, 0x8F);
+  EXPECT_TRUE(info.features.tsc);
+}
+#endif  // defined(CPU_FEATURES_OS_LINUX) || defined(CPU_FEATURES_OS_ANDROID)
+
+TEST_F(CpuidX86Test, CpuidNotCachedOnBareMetal) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+  });
+  GetX86Info();
+  const int calls = cpu().GetCpuidCalls();
+  GetX86Info();
+  EXPECT_GT(cpu().GetCpuidCalls(), calls);
+  EXPECT_FALSE(GetX86ConfidentialInfo().cpuid_expensive);
+}
+
+TEST_F(CpuidX86Test, CpuidCachedUnderHypervisor) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x0000001F, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0xFFFAF3FF, 0x1F8BFBFF}},
+      {{0x00000004, 0}, Leaf{0x1C004121, 0x02C0003F, 0x0000003F, 0x00000000}},
+      {{0x40000000, 0}, Leaf{0x40000001, 0x4B4D564B, 0x564B4D56, 0x0000004D}},
+  });
+  const auto info = GetX86Info();
+  GetX86CacheInfo();
+  GetX86HypervisorInfo();
+  const int calls = cpu().GetCpuidCalls();
+  EXPECT_STREQ(GetX86Info().vendor, info.vendor);
+  EXPECT_EQ(GetX86CacheInfo().size, 1);
+  EXPECT_EQ(GetX86HypervisorInfo().vendor, X86_HYPERVISOR_KVM);
+  EXPECT_EQ(cpu().GetCpuidCalls(), calls);
+  EXPECT_TRUE(GetX86ConfidentialInfo().cpuid_expensive);
+}
+
+TEST_F(CpuidX86Test, CpuidCacheEnabledOnRequest) {
+  cpu().SetLeaves({
+      {{0x00000000, 0}, Leaf{0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69}},
+      {{0x00000001, 0}, Leaf{0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF}},
+  });
+  EnableX86CpuidCache();
+  GetX86Info();
+  const int calls = cpu().GetCpuidCalls();
+  GetX86Info();
+  EXPECT_EQ(cpu().GetCpuidCalls(), calls);
+}
+
 // TODO(user): test what happens when xsave/osxsave are not present.
 // TODO(user): test what happens when xmm/ymm/zmm os support are not
 // present.
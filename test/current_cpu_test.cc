@@ -0,0 +1,87 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cpu_features_current_cpu.h"
+
+#include <sched.h>
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cpu_features {
+namespace {
+
+// Restricts the calling thread to `cpus` until destroyed.
+class ScopedAffinity {
+ public:
+  ScopedAffinity() { sched_getaffinity(0, sizeof(original_), &original_); }
+  ~ScopedAffinity() { sched_setaffinity(0, sizeof(original_), &original_); }
+
+  const cpu_set_t& original() const { return original_; }
+
+ private:
+  cpu_set_t original_;
+};
+
+TEST(CurrentCpuTest, ConcurrentSelection) {
+  // Runs first so that the threads race to select the method, they must all
+  // agree on it.
+  std::vector<std::thread> threads;
+  std::vector<CurrentCpuMethod> methods(8);
+  for (size_t i = 0; i < methods.size(); ++i) {
+    threads.emplace_back([&methods, i] {
+      methods[i] = CpuFeatures_GetCurrentCpuMethod();
+      EXPECT_GE(CpuFeatures_GetCurrentCpu(), 0);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (const CurrentCpuMethod method : methods) EXPECT_EQ(method, methods[0]);
+}
+
+TEST(CurrentCpuTest, MethodIsAvailable) {
+  const CurrentCpuMethod method = CpuFeatures_GetCurrentCpuMethod();
+  EXPECT_NE(method, CPU_FEATURE_CURRENT_CPU_NONE);
+  EXPECT_TRUE(CpuFeatures_IsCurrentCpuMethodAvailable(method));
+  EXPECT_FALSE(
+      CpuFeatures_IsCurrentCpuMethodAvailable(CPU_FEATURE_CURRENT_CPU_NONE));
+  EXPECT_EQ(CpuFeatures_GetCurrentCpuMethod(), method);
+}
+
+TEST(CurrentCpuTest, MatchesSchedGetcpuWhenPinned) {
+  ScopedAffinity affinity;
+  int tested = 0;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (!CPU_ISSET(cpu, &affinity.original())) continue;
+    cpu_set_t pinned;
+    CPU_ZERO(&pinned);
+    CPU_SET(cpu, &pinned);
+    // The thread runs on `cpu` once the call returns.
+    ASSERT_EQ(sched_setaffinity(0, sizeof(pinned), &pinned), 0);
+    EXPECT_EQ(sched_getcpu(), cpu);
+    EXPECT_EQ(CpuFeatures_GetCurrentCpu(), cpu);
+    for (int i = CPU_FEATURE_CURRENT_CPU_RSEQ; i <= CPU_FEATURE_CURRENT_CPU_OS;
+         ++i) {
+      const CurrentCpuMethod method = (CurrentCpuMethod)i;
+      if (CpuFeatures_IsCurrentCpuMethodAvailable(method))
+        EXPECT_EQ(CpuFeatures_GetCurrentCpuWithMethod(method), cpu) << i;
+    }
+    ++tested;
+  }
+  EXPECT_GT(tested, 0);
+}
+
+}  // namespace
+}  // namespace cpu_features
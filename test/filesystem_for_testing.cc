@@ -18,6 +18,7 @@
 #include <climits>
 #include <cstdio>
 #include <cstring>
+#include <set>
 #include <utility>
 
 namespace cpu_features {
@@ -30,6 +31,7 @@ FakeFile::~FakeFile() { assert(!opened_); }
 void FakeFile::Open() {
   assert(!opened_);
   opened_ = true;
+  head_index_ = 0;
 }
 
 void FakeFile::Close() {
@@ -48,7 +50,17 @@ int FakeFile::Read(int fd, void* buf, size_t count) {
   return (int)read;
 }
 
-void FakeFilesystem::Reset() { files_.clear(); }
+int FakeFile::Write(int fd, const void* buf, size_t count) {
+  assert(count < INT_MAX);
+  assert(fd == file_descriptor_);
+  written_content_.append(static_cast<const char*>(buf), count);
+  return (int)count;
+}
+
+void FakeFilesystem::Reset() {
+  files_.clear();
+  directories_.clear();
+}
 
 FakeFile* FakeFilesystem::CreateFile(const std::string& filename,
                                      const char* content) {
@@ -74,6 +86,34 @@ FakeFile* FakeFilesystem::FindFileOrDie(const int file_descriptor) const {
   return nullptr;
 }
 
+bool FakeFilesystem::CreateDirectory(const std::string& path) {
+  return directories_.insert(path).second;
+}
+
+bool FakeFilesystem::RemoveDirectory(const std::string& path) {
+  return directories_.erase(path) > 0;
+}
+
+bool FakeFilesystem::HasDirectory(const std::string& path) const {
+  return directories_.count(path) > 0;
+}
+
+bool FakeFilesystem::ListDirectory(const std::string& path,
+                                   std::vector<std::string>* names) const {
+  const std::string prefix = path + "/";
+  std::set<std::string> entries;
+  const auto add_entry = [&](const std::string& child) {
+    if (child.compare(0, prefix.size(), prefix) != 0) return;
+    const size_t end = child.find('/', prefix.size());
+    entries.insert(child.substr(prefix.size(), end - prefix.size()));
+  };
+  for (const auto& filename_file_pair : files_)
+    add_entry(filename_file_pair.first);
+  for (const auto& directory : directories_) add_entry(directory);
+  names->assign(entries.begin(), entries.end());
+  return !entries.empty() || HasDirectory(path);
+}
+
 static FakeFilesystem* kFilesystem = new FakeFilesystem();
 
 FakeFilesystem& GetEmptyFilesystem() {
@@ -100,4 +140,44 @@ extern "C" int CpuFeatures_ReadFile(int file_descriptor, void* buffer,
       ->Read(file_descriptor, buffer, buffer_size);
 }
 
+extern "C" int CpuFeatures_OpenFileForWriting(const char* filename) {
+  return CpuFeatures_OpenFile(filename);
+}
+
+extern "C" int CpuFeatures_WriteFile(int file_descriptor, const void* buffer,
+                                     size_t buffer_size) {
+  return kFilesystem->FindFileOrDie(file_descriptor)
+      ->Write(file_descriptor, buffer, buffer_size);
+}
+
+extern "C" int CpuFeatures_CreateDirectory(const char* path) {
+  return kFilesystem->CreateDirectory(path) ? 0 : -1;
+}
+
+extern "C" int CpuFeatures_RemoveDirectory(const char* path) {
+  return kFilesystem->RemoveDirectory(path) ? 0 : -1;
+}
+
+struct CpuFeatures_Directory {
+  std::vector<std::string> names;
+  size_t next = 0;
+};
+
+extern "C" CpuFeatures_Directory* CpuFeatures_OpenDirectory(const char* path) {
+  auto* const directory = new CpuFeatures_Directory();
+  if (kFilesystem->ListDirectory(path, &directory->names)) return directory;
+  delete directory;
+  return nullptr;
+}
+
+extern "C" const char* CpuFeatures_ReadDirectory(
+    CpuFeatures_Directory* directory) {
+  if (directory->next == directory->names.size()) return nullptr;
+  return directory->names[directory->next++].c_str();
+}
+
+extern "C" void CpuFeatures_CloseDirectory(CpuFeatures_Directory* directory) {
+  delete directory;
+}
+
 }  // namespace cpu_features
@@ -19,6 +19,8 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "internal/filesystem.h"
 
@@ -32,12 +34,15 @@ class FakeFile {
   void Open();
   void Close();
   int Read(int fd, void* buf, size_t count);
+  int Write(int fd, const void* buf, size_t count);
 
   int GetFileDescriptor() const { return file_descriptor_; }
+  const std::string& GetWrittenContent() const { return written_content_; }
 
  private:
   const int file_descriptor_;
   const std::string content_;
+  std::string written_content_;
   bool opened_ = false;
   size_t head_index_ = 0;
 };
@@ -48,10 +53,18 @@ class FakeFilesystem {
   FakeFile* CreateFile(const std::string& filename, const char* content);
   FakeFile* FindFileOrDie(const int file_descriptor) const;
   FakeFile* FindFileOrNull(const std::string& filename) const;
+  bool CreateDirectory(const std::string& path);
+  bool RemoveDirectory(const std::string& path);
+  bool HasDirectory(const std::string& path) const;
+  // Returns the sorted names of the files and directories directly under
+  // `path`, false if there are none.
+  bool ListDirectory(const std::string& path,
+                     std::vector<std::string>* names) const;
 
  private:
   int next_file_descriptor_ = 0;
   std::unordered_map<std::string, std::unique_ptr<FakeFile>> files_;
+  std::unordered_set<std::string> directories_;
 };
 
 FakeFilesystem& GetEmptyFilesystem();
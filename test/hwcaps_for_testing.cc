@@ -24,21 +24,30 @@ namespace {
 static auto* const g_hardware_capabilities = new HardwareCapabilities();
 static const char* g_platform_pointer = nullptr;
 static const char* g_base_platform_pointer = nullptr;
+static unsigned long g_min_sig_stack_size = 0;
+static unsigned long g_page_size = 0;
 }  // namespace
 
-void SetHardwareCapabilities(uint32_t hwcaps, uint32_t hwcaps2) {
+void SetHardwareCapabilities(uint64_t hwcaps, uint64_t hwcaps2,
+                             uint64_t hwcaps3, uint64_t hwcaps4) {
   g_hardware_capabilities->hwcaps = hwcaps;
   g_hardware_capabilities->hwcaps2 = hwcaps2;
+  g_hardware_capabilities->hwcaps3 = hwcaps3;
+  g_hardware_capabilities->hwcaps4 = hwcaps4;
 }
 void SetPlatformPointer(const char* string) { g_platform_pointer = string; }
 void SetBasePlatformPointer(const char* string) {
   g_base_platform_pointer = string;
 }
+void SetMinSigStackSize(unsigned long size) { g_min_sig_stack_size = size; }
+void SetPageSize(unsigned long size) { g_page_size = size; }
 
 void ResetHwcaps() {
   SetHardwareCapabilities(0, 0);
   SetPlatformPointer(nullptr);
   SetBasePlatformPointer(nullptr);
+  SetMinSigStackSize(0);
+  SetPageSize(0);
 }
 
 HardwareCapabilities CpuFeatures_GetHardwareCapabilities(void) {
@@ -48,5 +57,9 @@ const char* CpuFeatures_GetPlatformPointer(void) { return g_platform_pointer; }
 const char* CpuFeatures_GetBasePlatformPointer(void) {
   return g_base_platform_pointer;
 }
+unsigned long CpuFeatures_GetMinSigStackSize(void) {
+  return g_min_sig_stack_size;
+}
+unsigned long CpuFeatures_GetPageSize(void) { return g_page_size; }
 
 }  // namespace cpu_features
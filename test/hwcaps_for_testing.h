@@ -19,9 +19,12 @@
 
 namespace cpu_features {
 
-void SetHardwareCapabilities(uint32_t hwcaps, uint32_t hwcaps2);
+void SetHardwareCapabilities(uint64_t hwcaps, uint64_t hwcaps2,
+                             uint64_t hwcaps3 = 0, uint64_t hwcaps4 = 0);
 void SetPlatformPointer(const char* string);
 void SetBasePlatformPointer(const char* string);
+void SetMinSigStackSize(unsigned long size);
+void SetPageSize(unsigned long size);
 
 // To be called before each test.
 void ResetHwcaps();
@@ -0,0 +1,151 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "cpu_features_resctrl.h"
+
+#include <string>
+
+#include "filesystem_for_testing.h"
+#include "gtest/gtest.h"
+
+namespace cpu_features {
+namespace {
+
+TEST(ResctrlTest, CreateAndRemoveMonGroup) {
+  auto& fs = GetEmptyFilesystem();
+  EXPECT_EQ(CreateResctrlMonGroup("web"), 0);
+  EXPECT_TRUE(fs.HasDirectory("/sys/fs/resctrl/mon_groups/web"));
+  // Already exists.
+  EXPECT_EQ(CreateResctrlMonGroup("web"), -1);
+  EXPECT_EQ(RemoveResctrlMonGroup("web"), 0);
+  EXPECT_FALSE(fs.HasDirectory("/sys/fs/resctrl/mon_groups/web"));
+  EXPECT_EQ(RemoveResctrlMonGroup("web"), -1);
+  EXPECT_EQ(CreateResctrlMonGroup(nullptr), -1);
+}
+
+TEST(ResctrlTest, NameTooLong) {
+  GetEmptyFilesystem();
+  const std::string name(256, 'a');
+  EXPECT_EQ(CreateResctrlMonGroup(name.c_str()), -1);
+}
+
+TEST(ResctrlTest, AddTask) {
+  auto& fs = GetEmptyFilesystem();
+  auto* tasks = fs.CreateFile("/sys/fs/resctrl/mon_groups/web/tasks", "");
+  EXPECT_EQ(AddTaskToResctrlMonGroup("web", 1234), 0);
+  EXPECT_EQ(AddTaskToResctrlMonGroup("web", 5678), 0);
+  EXPECT_EQ(tasks->GetWrittenContent(), "1234\n5678\n");
+  EXPECT_EQ(AddTaskToResctrlMonGroup("db", 1234), -1);
+}
+
+TEST(ResctrlTest, ReadMonGroup) {
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/sys/fs/resctrl/mon_groups/web/mon_data/mon_L3_00/llc_occupancy",
+                "1179648\n");
+  fs.CreateFile(
+      "/sys/fs/resctrl/mon_groups/web/mon_data/mon_L3_00/mbm_total_bytes",
+      "33554432000\n");
+  fs.CreateFile(
+      "/sys/fs/resctrl/mon_groups/web/mon_data/mon_L3_00/mbm_local_bytes",
+      "Unavailable\n");
+  // Domains are not necessarily contiguous.
+  fs.CreateFile("/sys/fs/resctrl/mon_groups/web/mon_data/mon_L3_02/llc_occupancy",
+                "65536\n");
+  const auto data = ReadResctrlMonData("web");
+  ASSERT_EQ(data.size, 2);
+  EXPECT_EQ(data.domains[0].id, 0);
+  EXPECT_EQ(data.domains[0].llc_occupancy, 1179648);
+  EXPECT_EQ(data.domains[0].mbm_total_bytes, 33554432000);
+  EXPECT_EQ(data.domains[0].mbm_local_bytes, -1);
+  EXPECT_EQ(data.domains[1].id, 2);
+  EXPECT_EQ(data.domains[1].llc_occupancy, 65536);
+  EXPECT_EQ(data.domains[1].mbm_total_bytes, -1);
+}
+
+TEST(ResctrlTest, ReadDefaultGroup) {
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/sys/fs/resctrl/mon_data/mon_L3_00/llc_occupancy", "4096\n");
+  const auto data = ReadResctrlMonData(nullptr);
+  ASSERT_EQ(data.size, 1);
+  EXPECT_EQ(data.domains[0].llc_occupancy, 4096);
+}
+
+TEST(ResctrlTest, SparseDomainIds) {
+  auto& fs = GetEmptyFilesystem();
+  // Ids beyond the capacity are read, the lowest ones are kept.
+  for (int id = 0; id <= CPU_FEATURES_MAX_RESCTRL_DOMAINS; ++id) {
+    const std::string domain = "/sys/fs/resctrl/mon_data/mon_L3_" +
+                               std::to_string(CPU_FEATURES_MAX_RESCTRL_DOMAINS -
+                                              id + 100);
+    fs.CreateFile(domain + "/llc_occupancy", "4096\n");
+  }
+  fs.CreateFile("/sys/fs/resctrl/mon_data/mon_MB_00/llc_occupancy", "1\n");
+  const auto data = ReadResctrlMonData(nullptr);
+  EXPECT_TRUE(data.truncated);
+  ASSERT_EQ(data.size, CPU_FEATURES_MAX_RESCTRL_DOMAINS);
+  for (int i = 0; i < data.size; ++i) EXPECT_EQ(data.domains[i].id, 100 + i);
+}
+
+TEST(ResctrlTest, CounterOverflow) {
+  auto& fs = GetEmptyFilesystem();
+  fs.CreateFile("/sys/fs/resctrl/mon_data/mon_L3_00/mbm_total_bytes",
+                "9223372036854775808\n");
+  fs.CreateFile("/sys/fs/resctrl/mon_data/mon_L3_00/llc_occupancy", "0\n");
+  const auto data = ReadResctrlMonData(nullptr);
+  ASSERT_EQ(data.size, 1);
+  EXPECT_FALSE(data.truncated);
+  EXPECT_EQ(data.domains[0].llc_occupancy, 0);
+  EXPECT_EQ(data.domains[0].mbm_total_bytes, -1);
+}
+
+TEST(ResctrlTest, NotMounted) {
+  GetEmptyFilesystem();
+  EXPECT_EQ(ReadResctrlMonData("web").size, 0);
+  EXPECT_EQ(AddTaskToResctrlMonGroup("web", 1234), -1);
+}
+
+TEST(ResctrlTest, Delta) {
+  auto& fs = GetEmptyFilesystem();
+  const char kOccupancy[] =
+      "/sys/fs/resctrl/mon_groups/web/mon_data/mon_L3_00/llc_occupancy";
+  const char kTotal[] =
+      "/sys/fs/resctrl/mon_groups/web/mon_data/mon_L3_00/mbm_total_bytes";
+  const char kLocal[] =
+      "/sys/fs/resctrl/mon_groups/web/mon_data/mon_L3_00/mbm_local_bytes";
+  fs.CreateFile(kOccupancy, "1000\n");
+  fs.CreateFile(kTotal, "5000\n");
+  fs.CreateFile(kLocal, "4000\n");
+  const auto previous = ReadResctrlMonData("web");
+  fs.CreateFile(kOccupancy, "2000\n");
+  fs.CreateFile(kTotal, "8000\n");
+  fs.CreateFile(
+      "/sys/fs/resctrl/mon_groups/web/mon_data/mon_L3_01/mbm_total_bytes",
+      "100\n");
+  // The group has been recreated in between.
+  fs.CreateFile(kLocal, "10\n");
+  const auto current = ReadResctrlMonData("web");
+  const auto delta = GetResctrlMonDataDelta(&previous, &current);
+  ASSERT_EQ(delta.size, 2);
+  EXPECT_EQ(delta.domains[0].id, 0);
+  EXPECT_EQ(delta.domains[0].llc_occupancy, 2000);
+  EXPECT_EQ(delta.domains[0].mbm_total_bytes, 3000);
+  EXPECT_EQ(delta.domains[0].mbm_local_bytes, -1);
+  // No previous value.
+  EXPECT_EQ(delta.domains[1].id, 1);
+  EXPECT_EQ(delta.domains[1].mbm_total_bytes, -1);
+}
+
+}  // namespace
+}  // namespace cpu_features
@@ -137,6 +137,25 @@ TEST(StringViewTest, CpuFeatures_StringView_ParsePositiveNumber) {
   EXPECT_EQ(CpuFeatures_StringView_ParsePositiveNumber(str("-0x2A")), -1);
   EXPECT_EQ(CpuFeatures_StringView_ParsePositiveNumber(str("abc")), -1);
   EXPECT_EQ(CpuFeatures_StringView_ParsePositiveNumber(str("")), -1);
+  // Overflow.
+  EXPECT_EQ(CpuFeatures_StringView_ParsePositiveNumber(str("2147483647")),
+            2147483647);
+  EXPECT_EQ(CpuFeatures_StringView_ParsePositiveNumber(str("2147483648")), -1);
+}
+
+TEST(StringViewTest, CpuFeatures_StringView_ParsePositiveNumber64) {
+  EXPECT_EQ(CpuFeatures_StringView_ParsePositiveNumber64(str("33554432000")),
+            33554432000);
+  EXPECT_EQ(CpuFeatures_StringView_ParsePositiveNumber64(str("0x7d0000000")),
+            33554432000);
+  EXPECT_EQ(
+      CpuFeatures_StringView_ParsePositiveNumber64(str("9223372036854775807")),
+      INT64_MAX);
+  EXPECT_EQ(
+      CpuFeatures_StringView_ParsePositiveNumber64(str("9223372036854775808")),
+      -1);
+  EXPECT_EQ(CpuFeatures_StringView_ParsePositiveNumber64(str("Unavailable")),
+            -1);
 }
 
 TEST(StringViewTest, CpuFeatures_StringView_CopyString) {